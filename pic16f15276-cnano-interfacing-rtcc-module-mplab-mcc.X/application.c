@@ -15,76 +15,47 @@
 #include <xc.h>
 #include "application.h"
 #include "time.h"
+#include "command.h"
+#include "console.h"
+#include "timezone.h"
+#include "timestamp.h"
+#include "latency.h"
+#include "trace.h"
+#include "systime.h"
+#include "pinevent.h"
+#include "supervisor.h"
 
-// Internal RTCC and E2PROM Addresses
-#define EEADDR                      (0x64)                                     // EEPROM ADDRESS
-#define RTCC_ADDR                   (0x6F)                                     // RTCC REGISTER ADDRESS
-
-// RTCC Time Parameter Addresses
-#define RTCC_SECONDS                (0x00)                                     // CALENDAR & CLOCK REGISTER ADDRESSES
-#define RTCC_MINUTES                (0x01)
-#define RTCC_HOUR                   (0x02)
-#define RTCC_DAY                    (0x03)
-#define RTCC_DATE                   (0x04)
-#define RTCC_MONTH                  (0x05)
-#define RTCC_YEAR                   (0x06)
-
-#define CONTROL_REG                 (0x07)                                     // CONTROL AND CALIBRATION REGISTER ADDRESSES
-#define CALIBRATION                 (0x08)
-
-// RTCC Alarm0 Registers
-#define ALARM0_SECONDS              (0x0A)                                     // ALARM-0 REGISTER ADDRESSES
-#define ALARM0_MINUTES              (0x0B)
-#define ALARM0_HOUR                 (0x0C)
-#define ALARM0_DAY                  (0x0D)
-#define ALARM0_DATE                 (0x0E)
-#define ALARM0_MONTH                (0x0F)
-
-// RTCC Alarm1 Registers
-#define ALARM1_SECONDS              (0x11)                                     // ALARM-1 REGISTER ADDRESSES 
-#define ALARM1_MINUTES              (0x12)
-#define ALARM1_HOUR                 (0x13)
-#define ALARM1_DAY                  (0x14)
-#define ALARM1_DATE                 (0x15)
-#define ALARM1_MONTH                (0x16)
-
-// RTCC Power Down Mode Registers
-#define PWR_DOWN_MINUTES            (0x18)                                     // POWER DOWN MODE REGISTER ADDRESSES
-#define PWR_DOWN_HOUR               (0x19)
-#define PWR_DOWN_DATE               (0x1A)
-#define PWR_DOWN_MONTH              (0x1B)
-
-// RTCC Power Up Mode Registers
-#define PWR_UP_MINUTES              (0x1C)                                     // POWER UP MODE REGISTER ADDRESSES
-#define PWR_UP_HOUR                 (0x1D)
-#define PWR_UP_DATE                 (0x1E)
-#define PWR_UP_MONTH                (0x1F)
+#include "rtcc_map.h"
 
+#define RTCC_DEVICE                 (&MCP79410_Device)                         // MCP79410 or MCP7940N, the RTCC registers are the same
 
 /******************************************************************************/
 
-#define  SQWE                       (0x40)                                    //  Square Wave Enable BIT
 #define  ALM_NO                     (0x00)                                    //  no alarm activated
 #define  MFP_01H                    (0x00)                                    //  MFP = SQWAV(01 HERZ)
-#define  OSCON                      (0x20)                                    //  state of the oscillator(running or not)
-#define  VBATEN                     (0x08)                                    //  enable battery for back-up
-#define  VBAT_CLR                   (0xEF)                                    //  Mask to clear VBAT flag BIT
-#define  EXTOSC                     (0x08)                                    //  enable external 32khz signal
-#define  ST_SET                     (0x80)                                    //  start oscillator
-
-#define ALM_POL                     (0x07)                                    //  Alarm Polarity
-#define ALM_MSK                     (0x04)                                    //  Alarm Mask
+
 #define ALM0_EN                     (0x01)                                    //  Alarm0 enable
 #define ALM1_EN                     (0x01)                                    //  Alarm1 enable
 #define ALM0_NO                     (0x00)                                    //  Alarm0 disable
 #define ALM1_NO                     (0x00)                                    //  Alarm1 disable
 
-#define TIMESTAMP_LENGTH            (10)                                      //  Length of input timestamp
-#define ARRAYSIZE                   (10)                                      //  LENGTH of input array of characters
 #define ZERO                        (0)
-#define WR_DELAY					(5)
-#define RD_DELAY					(10)
 #define HOLD_TIME					(1000)
+#define OSC_STOP_TIMEOUT            (10)                                      //  ms for OSCRUN to clear once ST is cleared
+#define OSC_START_TIMEOUT           (2000)                                    //  ms crystal start up allowance
+#define OSC_POLL_DELAY              (1)                                       //  ms between OSCRUN checks
+
+// Positions in the Seconds..Year value list, which follows register order
+#define TIME_FIELDS                 (7)                                       //  Seconds..Year, read straight into a DateTime_t
+
+#define HEALTH_REGS                 (9)                                       //  Seconds..OSCTRIM
+#define HEALTH_CONFIG_FIELDS        (8)                                       //  Leading status fields compared with their initialized values
+#define SET_TIME_FIELDS             (9)                                       //  Time fields plus ST and the 12/24 hour select
+#define ALARM_FIELDS                (FIELD_ALARM_STRIDE)                      //  Seconds..Month of one alarm bank
+#define ALARM_FLAG_FIELDS           (4)                                       //  Weekday, IF, MSK and POL, the whole weekday register
+#define BATCH_FIELDS                (2)                                       //  Alarm enables, the banks go out as images
+#define VOTE_CHIPS                  (RTCC_REDUNDANT_MAX + 1)                  //  Primary plus the redundant chips
+#define VOTE_SKEW                   (1)                                       //  Seconds two readings may differ and still agree
 
 /*
  ***********************************************************
@@ -93,8 +64,14 @@
  *                                                         *
  ***********************************************************
 */
-static void rtcc_write(uint8_t addr, uint8_t data);
-static uint8_t rtcc_read(uint8_t addr);
+static uint8_t rtc6_EncodeTime(const DateTime_t *dt, uint8_t *ids, uint8_t *values);
+static bool rtc6_LoadAlarm(uint8_t alarm, const RtccAlarm_t *image);
+static void rtc6_ArmAlarm(uint8_t alarm, bool repeat);
+static void rtc6_TrackEnables(uint8_t enabled, uint8_t changed);
+static void rtc6_Publish(const RtccSnapshot_t *next);
+static bool rtc6_WriteDateTime(const RegMapDevice_t *dev, const uint8_t *ids, const uint8_t *values, uint8_t count);
+static void rtc6_KeepEdge(uint16_t edge);
+static void rtc6_PutEvent(const RtccAlarmEvent_t *event);
 
 /*
  ***********************************************************
@@ -103,13 +80,31 @@ static uint8_t rtcc_read(uint8_t addr);
  *                                                         *
  ***********************************************************
 */
-DateTime_t dateTime;
-unsigned int arrIndex = ZERO;
-unsigned char timeArray[ARRAYSIZE];
 unsigned char userInput;
-uint8_t setInterruptFlag = 0;
+volatile uint8_t setInterruptFlag = 0;
 time_t usertimestamp;
-volatile time_t readtime;
+
+static RtccSnapshot_t snapshots[2];                                          // Written by the main loop only
+static volatile uint8_t snapshotActive;                                      // Half that readers copy
+static const RegMapDevice_t *redundant[RTCC_REDUNDANT_MAX];                  // Set along with the primary, see rtc6_AddRedundant()
+static uint8_t redundantCount;
+static volatile Timestamp_t edgeTime;                                        // Wall clock of the latest MFP edge, written by the interrupt
+static RtccAlarmEvent_t lastAlarm;
+static bool alarmSeen;
+static uint32_t oscStartDeadline;                                            // End of the crystal start up allowance
+static uint8_t rtcHealth;                                                    // rtc6_CheckHealth() at the last initialization
+static uint8_t alarmArmed;                                                   // RTCC_ALARMx bits checked by rtc6_ServiceAlarms()
+static uint8_t alarmRepeat;                                                  // RTCC_ALARMx bits left armed after they fire
+
+#if INTERRUPT_STATS_ENABLE
+static const char *const interruptNames[INTERRUPT_SOURCE_COUNT] = {
+    " IOC", " INT", " BCL1", " SSP1", " RC1", " TX1", " TMR1"
+};
+#endif
+
+static const uint8_t timeFields[TIME_FIELDS] = {
+    FIELD_SECONDS, FIELD_MINUTES, FIELD_HOURS, FIELD_WEEKDAY, FIELD_DATE, FIELD_MONTH, FIELD_YEAR
+};
 /*
  ***********************************************************
  *                                                         *
@@ -118,153 +113,565 @@ volatile time_t readtime;
  ***********************************************************
 */
 
-static uint8_t rtcc_read(uint8_t addr) 
+// Lists the fields and values that set the clock, VBATEN and PWRFAIL are left as they are
+static uint8_t rtc6_EncodeTime(const DateTime_t *dt, uint8_t *ids, uint8_t *values)
 {
-    bool retStatus;
-    uint8_t readByte;
-    retStatus =  I2C1_WriteRead(RTCC_ADDR, &addr,1,&readByte,1);
-    if (retStatus)
+    static const uint8_t setTimeFields[SET_TIME_FIELDS] = {
+        FIELD_SECONDS, FIELD_ST, FIELD_MINUTES, FIELD_HOURS, FIELD_HOUR_12, FIELD_WEEKDAY, FIELD_DATE, FIELD_MONTH, FIELD_YEAR
+    };
+
+    memcpy(ids, setTimeFields, SET_TIME_FIELDS);
+    values[0] = dt->sec;
+    values[1] = 1;                                                           // Oscillator keeps running through the write
+    values[2] = dt->min;
+    values[3] = dt->hour;
+    values[4] = 0;                                                           // 24 hour format
+    values[5] = dt->wday;
+    values[6] = dt->mday;
+    values[7] = dt->month;
+    values[8] = dt->year;
+    return SET_TIME_FIELDS;
+}
+
+// Writes a prepared image to alarm bank 0 or 1 in one burst, which also clears ALMxIF
+static bool rtc6_LoadAlarm(uint8_t alarm, const RtccAlarm_t *image)
+{
+    return regmap_Write(RTCC_DEVICE, alarm ? RTCC_ALM1SEC : RTCC_ALM0SEC, image->reg, RTCC_ALARM_IMAGE_SIZE);
+}
+
+// Fills the idle half, then makes it the active one with a single byte write
+static void rtc6_Publish(const RtccSnapshot_t *next)
+{
+    uint8_t idle = snapshotActive ^ 1;
+
+    snapshots[idle] = *next;
+    snapshots[idle].sequence = snapshots[snapshotActive].sequence + 1;
+    snapshotActive = idle;
+}
+
+// Follows ALMxEN writes for the alarms in changed: enabled ones are polled, disabled ones stop being polled and lose their repeat
+static void rtc6_TrackEnables(uint8_t enabled, uint8_t changed)
+{
+    alarmArmed = (alarmArmed & ~changed) | (enabled & changed);
+    alarmRepeat &= (uint8_t)~(changed & ~enabled);
+}
+
+// Marks an alarm for rtc6_ServiceAlarms(), alarm is 0 or 1
+static void rtc6_ArmAlarm(uint8_t alarm, bool repeat)
+{
+    uint8_t bit = (uint8_t)(RTCC_ALARM0 << alarm);
+
+    alarmArmed |= bit;
+    alarmRepeat = repeat ? (alarmRepeat | bit) : (alarmRepeat & ~bit);
+}
+
+// One burst gives the time, the oscillator and battery status and the control register
+uint8_t rtc6_CheckHealth(void)
+{
+    static const uint8_t statusFields[] = {
+        FIELD_ST, FIELD_VBATEN, FIELD_HOUR_12, FIELD_SQWFS, FIELD_CRSTRIM, FIELD_EXTOSC, FIELD_SQWEN, FIELD_OUT, FIELD_OSCRUN, FIELD_PWRFAIL,
+        FIELD_ALM0EN, FIELD_ALM1EN
+    };
+    static const uint8_t configuredValues[HEALTH_CONFIG_FIELDS] = {1, 1, 0, MFP_01H, 0, 0, RTCC_MFP_SQWEN, 0};
+    uint8_t image[HEALTH_REGS];
+    uint8_t status[sizeof (statusFields)];
+    DateTime_t dt;
+    uint8_t health = RTCC_HEALTH_PRESENT;
+    RtccSnapshot_t next = snapshots[snapshotActive];
+
+    next.time = 0;
+    next.health = 0;
+    if (!regmap_Read(RTCC_DEVICE, RTCC_SECONDS, image, HEALTH_REGS)
+        || !regmap_Unpack(RTCC_DEVICE, statusFields, status, sizeof (statusFields), RTCC_SECONDS, image, HEALTH_REGS))
     {
-        while (I2C1_IsBusy())
-        {
-            I2C1_Tasks(); 
-        }      
+        rtc6_Publish(&next);
+        return 0;
+    }
+    if (memcmp(status, configuredValues, HEALTH_CONFIG_FIELDS) == 0)
+    {
+        health |= RTCC_HEALTH_CONFIGURED;
     }
-    return readByte;
+    if (status[HEALTH_CONFIG_FIELDS])
+    {
+        health |= RTCC_HEALTH_OSC_RUNNING;
+    }
+    if (status[HEALTH_CONFIG_FIELDS + 1])
+    {
+        health |= RTCC_HEALTH_VBAT_EVENT;
+    }
+    health |= (uint8_t)((status[HEALTH_CONFIG_FIELDS + 2] ? RTCC_HEALTH_ALARM0 : 0) | (status[HEALTH_CONFIG_FIELDS + 3] ? RTCC_HEALTH_ALARM1 : 0));
+    if (status[2] == 0                                                       // HOURS holds the AM/PM bit in 12 hour mode
+        && regmap_Unpack(RTCC_DEVICE, timeFields, (uint8_t *)&dt, TIME_FIELDS, RTCC_SECONDS, image, HEALTH_REGS) && datetime_IsValid(&dt))
+    {
+        health |= RTCC_HEALTH_TIME_VALID;
+        next.time = datetime_ToEpoch(&dt);
+    }
+    next.health = health;
+    rtc6_Publish(&next);
+    return health;
 }
 
-static void rtcc_write(uint8_t addr, uint8_t data) 
+uint8_t rtc6_Health(void)
 {
-    bool retStatus;
-    uint8_t txBuffer[2] = {0};
-    txBuffer[0] = addr;
-    txBuffer[1] = data;
-    retStatus = I2C1_Write(RTCC_ADDR, txBuffer, 2);
-    if (retStatus)
+    return rtcHealth;
+}
+
+// Initializes the RTC 6 Click board with default values and enabling Alarm0 mode on MFP Pin
+uint8_t rtc6_Initialize(void) 
+{
+    static const uint8_t controlFields[] = {FIELD_HOUR_12, FIELD_SQWFS, FIELD_CRSTRIM, FIELD_EXTOSC, FIELD_ALM0EN, FIELD_ALM1EN, FIELD_SQWEN, FIELD_OUT};
+    static const uint8_t controlValues[] = {0, MFP_01H, 0, 0, ALM_NO, ALM_NO, RTCC_MFP_SQWEN, 0};
+    static const uint8_t hourFields[] = {FIELD_HOUR_12, FIELD_HOURS};
+    uint8_t hours[sizeof (hourFields)];
+
+    regmap_Combine(RTCC_DEVICE);                                             // Writes are merged until the next commit
+    rtcHealth = rtc6_CheckHealth();
+    if ((rtcHealth & RTCC_HEALTH_WARM) == RTCC_HEALTH_WARM)
     {
-        while (I2C1_IsBusy())
+        if (rtcHealth & RTCC_HEALTH_VBAT_EVENT)
+        {
+            regmap_WriteField(RTCC_DEVICE, FIELD_PWRFAIL, 0);                // Battery kept the clock, only the flag is cleared
+        }
+        if (rtcHealth & RTCC_HEALTH_ALARM0)
+        {
+            rtc6_ArmAlarm(0, true);                                          // Enabled before the reset, kept armed as its mode is not known
+        }
+        if (rtcHealth & RTCC_HEALTH_ALARM1)
         {
-            I2C1_Tasks(); 
+            rtc6_ArmAlarm(1, true);
         }
+        return regmap_Commit() ? RTCC_INIT_READY : RTCC_INIT_FAILED;         // Warm boot, CONTROL and the alarm banks stay as they are
     }
-    __delay_ms(WR_DELAY);
+    if (regmap_ReadFields(RTCC_DEVICE, hourFields, hours, sizeof (hourFields)) && hours[0])
+    {
+        // Left in 12 hour mode, bit 5 of HOURS is PM and decodes as 20
+        hours[1] = (hours[1] >= 20) ? (uint8_t)((hours[1] - 20) % 12 + 12) : (uint8_t)(hours[1] % 12);
+        regmap_WriteField(RTCC_DEVICE, FIELD_HOURS, hours[1]);               // Same hour in 24 hour format
+    }
+    regmap_WriteField(RTCC_DEVICE, FIELD_VBATEN, 1);
+    regmap_WriteFields(RTCC_DEVICE, controlFields, controlValues, sizeof (controlFields));  // 24 hours, SQWEN=RTCC_MFP_SQWEN, NO ALARM is enabled
+    regmap_WriteField(RTCC_DEVICE, FIELD_ST, 1);                             // Enable the external crystal oscillator 
+    if (!regmap_Commit())
+    {
+        return RTCC_INIT_FAILED;
+    }
+    oscStartDeadline = systime_Millis() + OSC_START_TIMEOUT;
+    return RTCC_INIT_STARTING;
 }
 
+// One OSCRUN read per call, so the crystal start up does not hold the main loop
+uint8_t rtc6_PollStart(void)
+{
+    static const uint8_t batteryFields[] = {FIELD_VBATEN, FIELD_PWRFAIL};
+    static const uint8_t batteryValues[] = {1, 0};
 
-// Initializes the RTC 6 Click board with default values and enabling Alarm0 mode on MFP Pin
-void rtc6_Initialize(void) 
+    if (!regmap_ReadField(RTCC_DEVICE, FIELD_OSCRUN))
+    {
+        // No crystal or no chip, the caller carries on without a clock
+        return systime_Expired(oscStartDeadline) ? RTCC_INIT_FAILED : RTCC_INIT_STARTING;
+    }
+    regmap_WriteFields(RTCC_DEVICE, batteryFields, batteryValues, sizeof (batteryFields));  // Enable external battery and VBAT needs to be cleared
+    return regmap_Commit() ? RTCC_INIT_READY : RTCC_INIT_FAILED;
+}
+
+void rtc6_RequestService(void)
+{
+    setInterruptFlag = true;                                                 // Single byte, safe against the RB2 interrupt
+}
+
+ void rtc6_EnableAlarms(bool alarm0, bool alarm1)
 {
-    uint8_t reg = 0;
+    const uint8_t ids[2] = {FIELD_ALM0EN, FIELD_ALM1EN};
+    const uint8_t values[2] = {alarm0, alarm1};
+    regmap_WriteFields(RTCC_DEVICE, ids, values, 2);
+    rtc6_TrackEnables((alarm0 ? RTCC_ALARM0 : 0) | (alarm1 ? RTCC_ALARM1 : 0), RTCC_ALARM0 | RTCC_ALARM1);
+}
 
-    dateTime.day = (rtcc_read(RTCC_DAY) & 0x07);
-    rtcc_write(RTCC_DAY, (dateTime.day | 0x08));
-    dateTime.sec = rtcc_read(RTCC_SECONDS);
+bool rtc6_EnableAlarm(uint8_t alarm, bool enable)
+{
+    uint8_t bit = (uint8_t)(RTCC_ALARM0 << alarm);
 
-    rtcc_write(CONTROL_REG, ALM_NO + SQWE + MFP_01H);                        // SQWE=0, NO ALARM is enabled} 
-    
-    rtcc_write(RTCC_SECONDS, dateTime.sec | ST_SET);                         // Enable the external crystal oscillator 
-    while (!reg) 
+    if (alarm > 1 || !regmap_WriteField(RTCC_DEVICE, alarm ? FIELD_ALM1EN : FIELD_ALM0EN, enable))
     {
-        reg = rtcc_read(RTCC_DAY);
-        reg &= OSCON;
-    }    
-    rtcc_write(RTCC_DAY, dateTime.day | (VBATEN & VBAT_CLR));                // Enable external battery and VBAT needs to be cleared
+        return false;
+    }
+    rtc6_TrackEnables(enable ? bit : 0, bit);
+    return true;
 }
 
- void rtc6_EnableAlarms(bool alarm0, bool alarm1)
+// Checks the range and splits the timestamp, the registers are written by rtc6_SetDateTime()
+bool rtc6_SetTime(time_t t) 
 {
-    uint8_t reg = rtcc_read(CONTROL_REG);
-    reg = (reg & 0xCF) | (alarm0 << 4) | (alarm1 << 5);
-    rtcc_write(CONTROL_REG, reg);
+    DateTime_t dt;
+
+    if (!DATETIME_EPOCH_VALID((uint32_t)t))                                  // Two year digits, 2000..2099 only
+    {
+        return false;
+    }
+    datetime_FromEpoch((uint32_t)t, &dt);
+    return rtc6_SetDateTime(&dt);
 }
 
-// Sets the component to respective address on the RTC 6 Click Board
-static void rtc6_SetComponent(uint8_t location, uint8_t mask, uint8_t time)
+// Stops the oscillator, writes Seconds..Year in one burst with ST set again and checks the result with one burst read
+static bool rtc6_WriteDateTime(const RegMapDevice_t *dev, const uint8_t *ids, const uint8_t *values, uint8_t count)
 {
-    uint8_t inMemory = rtcc_read(location) & mask;
-    rtcc_write(location, inMemory | (time % 10) | ((time / 10) << 4)); 
+    uint8_t readBack[SET_TIME_FIELDS];
+    uint32_t deadline;
+
+    if (!regmap_WriteField(dev, FIELD_ST, 0))                                // No tick can land between the field writes
+    {
+        return false;
+    }
+    deadline = systime_Millis() + OSC_STOP_TIMEOUT;
+    while (regmap_ReadField(dev, FIELD_OSCRUN))
+    {
+        if (systime_Expired(deadline))
+        {
+            return false;
+        }
+        systime_DelayMs(OSC_POLL_DELAY);
+    }
+    if (!regmap_WriteFields(dev, ids, values, count) || !regmap_ReadFields(dev, ids, readBack, count))
+    {
+        return false;
+    }
+    return memcmp(values, readBack, count) == 0;                             // The restarted clock is still within the first second
 }
 
-// Sets the time parameters to the respective variables in the time structure
-void rtc6_SetTime(time_t t) 
+// The fields are encoded once and go to the primary first, then to each redundant chip
+bool rtc6_SetDateTime(const DateTime_t *dt)
 {
-    struct tm *tm_t;
-    memset(tm_t, 0, sizeof (tm_t));
+    uint8_t ids[SET_TIME_FIELDS];
+    uint8_t values[SET_TIME_FIELDS];
+    uint8_t count;
+    uint8_t i;
+    bool retStatus;
 
-    tm_t = localtime(&t);
-    rtc6_SetComponent(RTCC_YEAR, 0x00, tm_t->tm_year % 100);                 // RTC Click has only two digits for setting the year
-    rtc6_SetComponent(RTCC_MONTH, 0xD0, tm_t->tm_mon + 1);                   // time.h gives January as zero, clock expects 1
-    rtc6_SetComponent(RTCC_DATE, 0x00, tm_t->tm_mday);
-    rtc6_SetComponent(RTCC_MINUTES, 0x00, tm_t->tm_min);
-    rtc6_SetComponent(RTCC_SECONDS, 0x80, tm_t->tm_sec);
-    rtc6_SetComponent(RTCC_HOUR, 0x00, tm_t->tm_hour);
+    if (!datetime_IsValid(dt))
+    {
+        return false;
+    }
+    count = rtc6_EncodeTime(dt, ids, values);
+    retStatus = rtc6_WriteDateTime(RTCC_DEVICE, ids, values, count);
+    for (i = 0; i < redundantCount; i++)
+    {
+        retStatus &= rtc6_WriteDateTime(redundant[i], ids, values, count);
+    }
+    return retStatus;
 }
 
-// Gets the values from the RTC ^ registers to the local time structure
-static uint8_t rtc6_GetComponent(uint8_t location, uint8_t mask)
+bool rtc6_AddRedundant(const RegMapDevice_t *dev)
 {
-    uint8_t working = rtcc_read(location) & mask;
-    return (working & 0x0F) + (((working & (mask & 0xF0)) >> 4) * 10);
+    if (redundantCount >= RTCC_REDUNDANT_MAX)
+    {
+        return false;
+    }
+    redundant[redundantCount++] = dev;
+    return true;
 }
 
-// Respective time parameters are set into the local structure to make it readable for users
+// One Seconds..Year burst per chip is the least traffic a vote can cost, the chips cannot share a transaction
+uint8_t rtc6_VoteDateTime(DateTime_t *dt)
+{
+    DateTime_t reading[VOTE_CHIPS];
+    uint32_t epoch[VOTE_CHIPS];
+    bool valid[VOTE_CHIPS];
+    uint8_t chips = redundantCount + 1;
+    uint8_t best = 0;
+    uint8_t bestVotes = 0;
+    uint8_t votes;
+    uint8_t i;
+    uint8_t j;
+
+    valid[0] = rtc6_GetDateTime(&reading[0]);                                // Primary, also refreshes the snapshot
+    for (i = 1; i < chips; i++)
+    {
+        valid[i] = regmap_ReadFields(redundant[i - 1], timeFields, (uint8_t *)&reading[i], TIME_FIELDS)
+                   && datetime_IsValid(&reading[i]);
+    }
+    for (i = 0; i < chips; i++)
+    {
+        epoch[i] = valid[i] ? datetime_ToEpoch(&reading[i]) : 0;
+    }
+    for (i = 0; i < chips; i++)
+    {
+        votes = 0;
+        for (j = 0; valid[i] && j < chips; j++)
+        {
+            if (valid[j] && (epoch[i] > epoch[j] ? epoch[i] - epoch[j] : epoch[j] - epoch[i]) <= VOTE_SKEW)
+            {
+                votes++;
+            }
+        }
+        if (votes > bestVotes)
+        {
+            best = i;
+            bestVotes = votes;
+        }
+    }
+    if (bestVotes * 2 <= chips)                                              // A single chip is its own majority
+    {
+        return 0;
+    }
+    *dt = reading[best];
+    return bestVotes;
+}
+
+// Respective time parameters are read in one burst to make it readable for users
 time_t rtc6_GetTime(void) 
 {
-    struct tm tm_t;
-    memset(&tm_t, 0, sizeof (tm_t));
-    
-    tm_t.tm_year = rtc6_GetComponent(RTCC_YEAR, 0xFF) + 100;    // Result only has two digits, this assumes 20xx
-    tm_t.tm_mon = rtc6_GetComponent(RTCC_MONTH, 0x1F) - 1;      // time.h expects January as zero, clock gives 1
-    tm_t.tm_mday = rtc6_GetComponent(RTCC_DATE, 0x3F);
-    tm_t.tm_hour = rtc6_GetComponent(RTCC_HOUR, 0x3F);
-    tm_t.tm_min = rtc6_GetComponent(RTCC_MINUTES, 0x7F);
-    tm_t.tm_sec = rtc6_GetComponent(RTCC_SECONDS, 0x7F);
+    DateTime_t dt;
 
-    return mktime(&tm_t);
+    if (!rtc6_GetDateTime(&dt))
+    {
+        return 0;
+    }
+    return (time_t)datetime_ToEpoch(&dt);
 }
 
-void rtc6_SetAlarm0(struct tm tm_t, bool almpol, uint8_t mask)
+// The field list follows the register order, which is also the DateTime_t layout
+bool rtc6_GetDateTime(DateTime_t *dt)
 {
-    rtcc_write(ALARM0_SECONDS, tm_t.tm_sec);
-    rtcc_write(ALARM0_MINUTES, tm_t.tm_min);
-    rtcc_write(ALARM0_HOUR, tm_t.tm_hour);
-    rtcc_write(ALARM0_DATE, tm_t.tm_mday);
-    rtcc_write(ALARM0_MONTH, tm_t.tm_mon + 1);                               // time.h gives January as zero, clock expects 1
-    rtcc_write(ALARM0_DAY, tm_t.tm_wday | almpol << ALM_POL | mask << ALM_MSK);
+    RtccSnapshot_t next = snapshots[snapshotActive];
+    bool retStatus = regmap_ReadFields(RTCC_DEVICE, timeFields, (uint8_t *)dt, TIME_FIELDS)
+                     && datetime_IsValid(dt);                                // Register contents are not a calendar time otherwise
+
+    next.time = retStatus ? datetime_ToEpoch(dt) : 0;
+    rtc6_Publish(&next);
+    return retStatus;
+}
+
+void rtc6_Snapshot(RtccSnapshot_t *snapshot)
+{
+    *snapshot = snapshots[snapshotActive];
+}
+
+// Every field of the bank is listed, so the image does not depend on the register contents
+bool rtc6_PrepareAlarm(const DateTime_t *dt, bool almpol, uint8_t mask, RtccAlarm_t *alarm)
+{
+    uint8_t ids[ALARM_FIELDS];
+    uint8_t values[ALARM_FIELDS];
+    uint8_t i;
+
+    if (!datetime_IsValid(dt) || !RTCC_ALARM_MATCH_VALID(mask))
+    {
+        return false;
+    }
+    for (i = 0; i < ALARM_FIELDS; i++)
+    {
+        ids[i] = (uint8_t)(FIELD_ALM0_SECONDS + i);
+    }
+    values[0] = dt->sec;
+    values[1] = dt->min;
+    values[2] = dt->hour;
+    values[3] = dt->wday;
+    values[4] = 0;                                                           // Clears a pending match
+    values[5] = mask;
+    values[6] = almpol;
+    values[7] = dt->mday;
+    values[8] = dt->month;
+    memset(alarm->reg, 0, RTCC_ALARM_IMAGE_SIZE);
+    return regmap_Pack(RTCC_DEVICE, ids, values, ALARM_FIELDS, RTCC_ALM0SEC, alarm->reg, RTCC_ALARM_IMAGE_SIZE);
+}
+
+bool rtc6_SetAlarm0(const RtccAlarm_t *alarm)
+{
+    rtc6_ArmAlarm(0, false);
+    return rtc6_LoadAlarm(0, alarm);
 }
 
 void rtc6_ClearAlarm0(void)
 {
-    uint8_t reg = rtcc_read(ALARM0_DAY);
-    rtcc_write(ALARM0_DAY, reg);
+    regmap_WriteField(RTCC_DEVICE, FIELD_ALM0_IF, 0);
 }
 
-void rtc6_SetAlarm1(struct tm tm_t, bool almpol, uint8_t mask)
+bool rtc6_SetAlarm1(const RtccAlarm_t *alarm)
 {
-    rtcc_write(ALARM1_SECONDS, tm_t.tm_sec);
-    rtcc_write(ALARM1_MINUTES, tm_t.tm_min);
-    rtcc_write(ALARM1_HOUR, tm_t.tm_hour);
-    rtcc_write(ALARM1_DATE, tm_t.tm_mday);
-    rtcc_write(ALARM1_MONTH, tm_t.tm_mon + 1);                               // time.h gives January as zero, clock expects 1
-    rtcc_write(ALARM1_DAY, tm_t.tm_wday | almpol << ALM_POL | mask << ALM_MSK);
+    rtc6_ArmAlarm(1, false);
+    return rtc6_LoadAlarm(1, alarm);
 }
 
 // Clears the previous alarm status if any at initialization
 void rtc6_ClearAlarm1(void)
 {
-    uint8_t reg = rtcc_read(ALARM1_DAY);
-    rtcc_write(ALARM1_DAY, reg);
+    regmap_WriteField(RTCC_DEVICE, FIELD_ALM1_IF, 0);
 }
 
-// Interrupt Function for alarm match condition
-void Rtcc_External_Interrupt(void)
+bool rtc6_SetRepeatingAlarm(uint8_t alarm, time_t first, uint8_t match)
 {
+    RtccAlarm_t image;
+    DateTime_t dt;
+
+    datetime_FromEpoch((uint32_t)first, &dt);
+    if (alarm > 1 || !rtc6_PrepareAlarm(&dt, RTCC_ALARM_ACTIVE_HIGH, match, &image))
+    {
+        return false;
+    }
+    if (!rtc6_LoadAlarm(alarm, &image) || !regmap_WriteField(RTCC_DEVICE, alarm ? FIELD_ALM1EN : FIELD_ALM0EN, 1) || !regmap_Commit())
+    {
+        return false;
+    }
+    rtc6_ArmAlarm(alarm, true);
+    return true;
+}
+
+uint8_t rtc6_ServiceAlarms(void)
+{
+    static const uint8_t flagFields[2 * ALARM_FLAG_FIELDS] = {
+        FIELD_ALM0_WEEKDAY, FIELD_ALM0_IF, FIELD_ALM0_MSK, FIELD_ALM0_POL,
+        FIELD_ALM1_WEEKDAY, FIELD_ALM1_IF, FIELD_ALM1_MSK, FIELD_ALM1_POL
+    };
+    uint8_t value[2 * ALARM_FLAG_FIELDS];
+    uint8_t *bank;
+    uint8_t fired = 0;
+    RtccSnapshot_t next;
+    uint8_t bit;
+    uint8_t alarm;
+
+    if (!alarmArmed || !regmap_ReadFields(RTCC_DEVICE, flagFields, value, sizeof (flagFields)))
+    {
+        return 0;                                                            // No bus traffic while nothing is armed
+    }
+    for (alarm = 0; alarm < 2; alarm++)
+    {
+        bit = (uint8_t)(RTCC_ALARM0 << alarm);
+        bank = &value[alarm * ALARM_FLAG_FIELDS];
+        if (!(alarmArmed & bit) || !bank[1])
+        {
+            continue;
+        }
+        fired |= bit;
+        bank[1] = 0;                                                         // Same weekday, mask and polarity with IF cleared
+        regmap_WriteFields(RTCC_DEVICE, &flagFields[alarm * ALARM_FLAG_FIELDS], bank, ALARM_FLAG_FIELDS);
+        if (!(alarmRepeat & bit))
+        {
+            alarmArmed &= ~bit;
+        }
+    }
+    regmap_Commit();
+    next = snapshots[snapshotActive];
+    next.alarms = fired;
+    rtc6_Publish(&next);
+    return fired;
+}
+
+// Sets the time through rtc6_SetTime(), then applies the alarm fields as one update and commits it
+bool rtc6_ExecuteBatch(RtccBatch_t *batch)
+{
+    uint8_t ids[BATCH_FIELDS];
+    uint8_t values[BATCH_FIELDS];
+    uint8_t count = 0;
+    bool retStatus = true;
+    RtccAlarm_t image;
+    DateTime_t dt;
+
+    if (batch->ops & RTCC_BATCH_SET_TIME)
+    {
+        retStatus = rtc6_SetTime(batch->time);                               // The only path that writes the clock
+    }
+    if (batch->ops & RTCC_BATCH_ENABLE)
+    {
+        ids[count] = FIELD_ALM0EN;
+        values[count++] = batch->alarm0Enable;
+        ids[count] = FIELD_ALM1EN;
+        values[count++] = batch->alarm1Enable;
+    }
+    if (retStatus && (batch->ops & RTCC_BATCH_SET_ALARM0))
+    {
+        datetime_FromEpoch((uint32_t)batch->alarm0, &dt);
+        retStatus = rtc6_PrepareAlarm(&dt, RTCC_ALARM_ACTIVE_HIGH, RTCC_ALARM_MATCH_FULL, &image) && rtc6_SetAlarm0(&image);
+    }
+    if (retStatus && (batch->ops & RTCC_BATCH_SET_ALARM1))
+    {
+        datetime_FromEpoch((uint32_t)batch->alarm1, &dt);
+        retStatus = rtc6_PrepareAlarm(&dt, RTCC_ALARM_ACTIVE_HIGH, RTCC_ALARM_MATCH_FULL, &image) && rtc6_SetAlarm1(&image);
+    }
+
+    if (retStatus && count)
+    {
+        retStatus = regmap_WriteFields(RTCC_DEVICE, ids, values, count);
+        rtc6_TrackEnables((batch->alarm0Enable ? RTCC_ALARM0 : 0) | (batch->alarm1Enable ? RTCC_ALARM1 : 0), RTCC_ALARM0 | RTCC_ALARM1);
+    }
+    retStatus = retStatus && regmap_Commit();                                // Alarm images and enables go out together
+    if (retStatus && (batch->ops & RTCC_BATCH_READ_BACK))
+    {
+        retStatus = rtc6_GetDateTime(&dt);
+        batch->readBack = retStatus ? (time_t)datetime_ToEpoch(&dt) : 0;
+    }
+    return retStatus;
+}
+
+// Reads from the battery backed SRAM, offset is relative to the start of the SRAM
+bool rtc6_ReadSram(uint8_t offset, uint8_t *data, uint8_t length)
+{
+    if ((uint16_t)offset + length > RTCC_SRAM_SIZE)
+    {
+        return false;
+    }
+    return regmap_Read(RTCC_DEVICE, RTCC_SRAM + offset, data, length);
+}
+
+// Writes to the battery backed SRAM, offset is relative to the start of the SRAM
+bool rtc6_WriteSram(uint8_t offset, const uint8_t *data, uint8_t length)
+{
+    if ((uint16_t)offset + length > RTCC_SRAM_SIZE || length > REGMAP_SPAN_MAX)
+    {
+        return false;
+    }
+    return regmap_Write(RTCC_DEVICE, RTCC_SRAM + offset, data, length);
+}
+
+bool rtc6_LastAlarm(RtccAlarmEvent_t *event)
+{
+    *event = lastAlarm;
+    return alarmSeen;
+}
+
+// Stamps the edge for the alarm record, called from the RB2 interrupt
+static void rtc6_KeepEdge(uint16_t edge)
+{
+    Timestamp_t time;
+
+    latency_Edge(edge);
+    timestamp_At(edge, &time);
+    edgeTime.seconds = time.seconds;
+    edgeTime.millis = time.millis;
+}
+
+// Prints the alarm time with the interrupt latency and the main loop delay in microseconds
+static void rtc6_PutEvent(const RtccAlarmEvent_t *event)
+{
+    console_PutString("\t\r At ");
+    console_PutIso8601(&event->time);
+    console_PutString(", interrupt after ");
+    console_PutUnsigned((uint32_t)(uint16_t)(event->timing.entry - event->timing.edge) * 1000000UL / TMR1_NOMINAL_FREQUENCY, 0);
+    console_PutString(" us, serviced after ");
+    console_PutUnsigned((uint32_t)(uint16_t)(event->timing.handled - event->timing.edge) * 1000000UL / TMR1_NOMINAL_FREQUENCY, 0);
+    console_PutString(" us \n");
+}
+
+// Interrupt Function for the 1 Hz square wave, alarm flags are checked on each second
+void Rtcc_External_Interrupt(uint16_t edge)
+{
+    timestamp_Tick(edge);                                                         // Latch Timer1 on the 1 Hz edge
+    rtc6_KeepEdge(edge);                                                          // A flag found on this check was set at this edge
     setInterruptFlag = true;                                                      // To call up the clear register value function
 }
 
+// Interrupt Function for alarm match condition when MFP is an alarm output
+void Rtcc_Alarm_Interrupt(uint16_t edge)
+{
+    rtc6_KeepEdge(edge);
+    setInterruptFlag = true;
+}
+
 // Main Application Code
 void rtc_Application(void) 
 {
+    uint8_t alarms;
+    RtccAlarmEvent_t event;
+    uint8_t iocEnabled;
+
     if(EUSART1_IsRxReady()) 
     {        
         userInput=EUSART1_Read();
@@ -274,68 +681,192 @@ void rtc_Application(void)
         {          
          case 'A':                                                          // Case-A defines the functionality for user to set the timestamp
             {
-                printf("\n\t\r Option selected is : %c \n", userInput);
-                printf("\n\t\r Enter the timestamp \n");
-                printf("\n\t\r Format is in epochs (universal time ticks)\n");
-
-                while(!EUSART1_IsRxReady());
-                userInput = EUSART1_Read();
-                
-                if(arrIndex != TIMESTAMP_LENGTH)
+                console_PutString("\n\t\r Option selected is : ");
+                console_PutChar((char)userInput);
+                console_PutString(" \n");
+                console_PutString("\n\t\r Enter the timestamp \n");
+                console_PutString("\n\t\r Format is in epochs (universal time ticks)\n");
+
+                if(command_ReadEpoch(&usertimestamp))                        // Digits are parsed as they arrive, ended by Enter
                 {
-                    for (arrIndex=0;arrIndex<TIMESTAMP_LENGTH;arrIndex++) // Accepting epoch time from the data visualizer
+                    console_PutString("\n\t\r seconds since the Epoch: ");
+                    console_PutUnsigned((uint32_t)usertimestamp, 0);
+                    console_PutString("\n");
+                    if(rtc6_SetTime(usertimestamp))                          // Writes the user defined timestamp to the registers
+                    {
+                        timestamp_Sync(usertimestamp);
+                        console_PutString("\nTime and Date is Set \n\n");
+                    }
+                    else
                     {
-                        timeArray[arrIndex] = userInput;                    // Adding up the characters received
-                        while(!EUSART1_IsRxReady());
-                        userInput = EUSART1_Read();
+                        console_PutString("\nTime was not set, check the RTCC \n\n");
                     }
-                    usertimestamp = atoll(timeArray);
-                    printf("\n\t\r seconds since the Epoch: %ld\n", (long) usertimestamp);
-                    arrIndex = ZERO;
-                    __delay_ms(RD_DELAY);
-                    rtc6_SetTime(usertimestamp);                             // Writes the user defined timestamp to the registers
-                }                
-                printf("\nTime and Date is Set \n\n");
+                }
+                else
+                {
+                    console_PutString("\n\t\r Invalid timestamp, expected 2000..2099 \n\n");
+                }
                 break;
             }
          case 'B':                                                          // Case-B defines the functionality for user to set the alarm
             {
-                printf("\n\t\r Option selected is : %c \n", userInput);
-                struct tm *tm_t_alarm;
+                console_PutString("\n\t\r Option selected is : ");
+                console_PutChar((char)userInput);
+                console_PutString(" \n");
+                DateTime_t alarmTime;
+                RtccAlarm_t alarmImage;
                 rtc6_ClearAlarm0();
-                rtc6_EnableAlarms(ALM0_EN,ALM1_NO);
-                printf("\n\t\r Enter alarm time : \n");
-                printf("\n\t\r Format is in epochs (universal time ticks) \n");
-
-                while(!EUSART1_IsRxReady());
-                userInput = EUSART1_Read();
-                
-                if(arrIndex != TIMESTAMP_LENGTH)
+                console_PutString("\n\t\r Enter alarm time : \n");
+                console_PutString("\n\t\r Format is in epochs (universal time ticks) \n");
+
+                if(command_ReadEpoch(&usertimestamp))                        // Digits are parsed as they arrive, ended by Enter
                 {
-                    for (arrIndex=0;arrIndex<TIMESTAMP_LENGTH;arrIndex++) // Accepting epoch time from the data visualizer
+                    datetime_FromEpoch((uint32_t)usertimestamp, &alarmTime);
+                    console_PutString("\n\t\r Seconds since the Epoch: ");
+                    console_PutUnsigned((uint32_t)usertimestamp, 0);
+                    console_PutString("\n");
+                    if(rtc6_PrepareAlarm(&alarmTime, RTCC_ALARM_ACTIVE_HIGH, RTCC_ALARM_MATCH_FULL, &alarmImage)
+                       && rtc6_SetAlarm0(&alarmImage)                        // Writes the alarm timestamp to the registers
+                       && rtc6_EnableAlarm(0, true))                         // Alarm 1 and its repeat are left as they are
                     {
-                        timeArray[arrIndex] = userInput;                     // Adding up the characters received
-                        while(!EUSART1_IsRxReady());
-                        userInput = EUSART1_Read();
+                        console_PutString("\n\t\r Alarm Time is Set \n\n");
                     }
-                    usertimestamp = atoll(timeArray);
-                    arrIndex = ZERO;
-                    __delay_ms(RD_DELAY);
-                    tm_t_alarm = localtime(&usertimestamp);
-                    printf("\n\t\r Seconds since the Epoch: %ld\n", (long) usertimestamp);
-                    rtc6_SetAlarm0(*tm_t_alarm, ALM_POL, ALM_MSK);           // Writes the alarm timestamp to the registers
+                    else
+                    {
+                        console_PutString("\n\t\r Alarm was not set, check the RTCC \n\n");
+                    }
+                }
+                else
+                {
+                    console_PutString("\n\t\r Invalid timestamp, expected 2000..2099 \n\n");
+                }
+                break;
+            }
+         case 'R':                                                           // Case-R sets a repeating alarm on alarm 1
+            {
+                uint8_t match;
+                console_PutString("\n\t\r Option selected is : ");
+                console_PutChar((char)userInput);
+                console_PutString(" \n");
+                console_PutString("\n\t\r Enter match : 0 seconds, 1 minutes, 2 hours, 3 weekday, 4 date \n");
+                while(!EUSART1_IsRxReady())
+                {
+                    supervisor_Wait();
+                }
+                match = (uint8_t)(EUSART1_Read() - '0');
+                console_PutString("\n\t\r Enter first alarm time in epochs \n");
+
+                if(match <= RTCC_ALARM_MATCH_DATE && command_ReadEpoch(&usertimestamp) && rtc6_SetRepeatingAlarm(1, usertimestamp, match))
+                {
+                    console_PutString("\n\t\r Repeating Alarm is Set \n\n");
+                }
+                else
+                {
+                    console_PutString("\n\t\r Invalid match or timestamp \n\n");
                 }
-                printf("\n\t\r Alarm Time is Set \n\n");
                 break;
             }
          case 'C':                                                           // Case-C defines the functionality for user to read the timestamp
             {
-                printf("\n\t\r Reading Current Time \n\n");
-                struct tm *read_tm_t;                                                      
-                readtime = rtc6_GetTime();                                   // Reads the timestamp at the current instant
-                read_tm_t = localtime(&readtime);
-                printf("\t\r Current time is : %04d-%02d-%02d %02d:%02d:%02d\n", read_tm_t->tm_year+1900, read_tm_t->tm_mon+1, read_tm_t->tm_mday, read_tm_t->tm_hour+5, read_tm_t->tm_min+30, read_tm_t->tm_sec);
-                __delay_ms(HOLD_TIME);
+                console_PutString("\n\t\r Reading Current Time \n\n");
+                struct tm read_tm_t;                                                      
+                DateTime_t voted;
+                uint8_t votes = rtc6_VoteDateTime(&voted);                   // Reads the timestamp at the current instant, from every chip
+                time_t readtime = votes ? (time_t)datetime_ToEpoch(&voted) : 0;
+                if(readtime == 0)
+                {
+                    console_PutString("\t\r Clock registers do not hold a valid time \n");
+                }
+                else
+                {
+                    timezone_ToLocal((uint32_t)readtime, &read_tm_t);        // Chip keeps UTC, render in the configured zone
+                    console_PutString("\t\r Current time is : ");
+                    console_PutDateTime(&read_tm_t);
+                    console_PutString("\n");
+                    if (redundantCount)
+                    {
+                        console_PutString("\t\r Clocks agreeing : ");
+                        console_PutUnsigned(votes, 0);
+                        console_PutString(" of ");
+                        console_PutUnsigned(redundantCount + 1U, 0);
+                        console_PutString("\n");
+                    }
+                }
+                systime_DelayMs(HOLD_TIME);
+                break;
+            }
+         case 'D':                                                           // Case-D executes a list of operations in one pass
+            {
+                console_PutString("\n\t\r Option selected is : ");
+                console_PutChar((char)userInput);
+                console_PutString(" \n");
+                console_PutString("\n\t\r Enter the batch, ended by Enter \n");
+                console_PutString("\n\t\r Format is T<epoch> A<epoch> B<epoch> E<alarm0><alarm1> R \n");
+                command_TextBatch();
+                break;
+            }
+         case 'S':                                                           // Case-S shows the millisecond timestamp
+            {
+                Timestamp_t now;
+                timestamp_Now(&now);
+                console_PutString("\n\t\r Timestamp : ");
+                console_PutIso8601(&now);
+                console_PutString("\n\t\r Monotonic : ");
+                console_PutUnsigned(timestamp_Monotonic(), 0);
+                console_PutString(" ms \n\n");
+                break;
+            }
+         case 'Z':                                                           // Case-Z configures the time zone used to show the time
+            {
+                console_PutString("\n\t\r Option selected is : ");
+                console_PutChar((char)userInput);
+                console_PutString(" \n");
+                console_PutString("\n\t\r Enter offset [dst sm sw sd st em ew ed et], ended by Enter \n");
+                console_PutString("\n\t\r Minutes east of UTC, week 5 = last, weekday 0 = Sunday \n");
+                command_TimeZone();
+                break;
+            }
+#if TRACE_ENABLE
+         case 'T':                                                           // Case-T dumps the I2C and UART trace
+            {
+                trace_Dump();
+                break;
+            }
+#endif
+#if INTERRUPT_STATS_ENABLE
+         case 'I':                                                           // Case-I reports interrupt entries and worst service times
+            {
+                INTERRUPT_STATS stats;
+                uint8_t source;
+                console_PutString("\n\t\r Source\t entries\t worst us \n");
+                for(source = 0; source < INTERRUPT_SOURCE_COUNT; source++)
+                {
+                    INTERRUPT_StatsGet((INTERRUPT_SOURCE)source, &stats);
+                    console_PutString("\t\r");
+                    console_PutString(interruptNames[source]);
+                    console_PutChar('\t');
+                    console_PutUnsigned(stats.count, 0);
+                    console_PutChar('\t');
+                    console_PutUnsigned(stats.worst / INTERRUPT_STATS_COUNTS_PER_US, 0);
+                    console_PutString("\n");
+                }
+                console_PutString("\t\r Rejected MFP edges : ");
+                console_PutUnsigned(pinevent_Glitches(), 0);
+                console_PutString("\n\n");
+                INTERRUPT_StatsClear();
+                break;
+            }
+#endif
+#if LATENCY_ENABLE
+         case 'L':                                                           // Case-L reports the alarm path latency
+            {
+                latency_Report();
+                break;
+            }
+#endif
+         case COMMAND_BATCH_SOF:                                             // Binary batch frame from a host tool
+            {
+                command_BinaryBatch();
                 break;
             }
          default:
@@ -343,18 +874,45 @@ void rtc_Application(void)
                 break;
             }       
         }
+        regmap_Commit();                                                     // Sends the register writes the option left held
     }
     
-    // Checks if the interrupt flag is set to 2 for alarm message and also to  clear the alarm registers
-    
-    // This loop Can be added to indicate Alarm Time has occurred
-//    if(setInterruptFlag == 2)                                           
-//    {
-//        setInterruptFlag = 0;                                                // Reset Interrupt Flag
-//        for(int i=0;i<3;i++)
-//        {
-//            printf("\n\t\r -------ALARM------- \n");                         // Display alarm message on terminal
-//        }                                                 
-//        rtc6_ClearAlarm0();                                                  // Clear Alarm Register
-//    }
+    // Each 1 Hz edge checks the alarm flags, repeating alarms are rearmed by the service
+    if(setInterruptFlag)
+    {
+        setInterruptFlag = 0;                                                // Reset Interrupt Flag
+        if (latency_Take(&event.timing))
+        {
+            iocEnabled = PIE0bits.IOCIE;
+            PIE0bits.IOCIE = 0;
+            event.time.seconds = edgeTime.seconds;
+            event.time.millis = edgeTime.millis;
+            PIE0bits.IOCIE = iocEnabled;
+        }
+        else
+        {
+            timestamp_Now(&event.time);                                      // Requested by rtc6_RequestService(), no edge to time
+        }
+        alarms = rtc6_ServiceAlarms();
+        if(alarms)
+        {
+            LATENCY_MARK(LATENCY_CLEARED);                                   // ALMxIF write has completed
+            event.alarms = alarms;
+            lastAlarm = event;
+            alarmSeen = true;
+        }
+        if(alarms & RTCC_ALARM0)
+        {
+            console_PutString("\n\t\r -------ALARM 0------- \n");         // Display alarm message on terminal
+        }
+        if(alarms & RTCC_ALARM1)
+        {
+            console_PutString("\n\t\r -------ALARM 1------- \n");
+        }
+        if(alarms)
+        {
+            rtc6_PutEvent(&event);
+        }
+    }
+    supervisor_Checkpoint(SUPERVISOR_CHECK_CONSOLE);
 }
\ No newline at end of file
@@ -42,65 +42,260 @@ extern "C" {
 #include <string.h>
 #include "mcc_generated_files/system/system.h"
 #include "mcc_generated_files/i2c_host/mssp1.h"
+#include "datetime.h"
+#include "regmap.h"
+#include "timestamp.h"
+#include "latency.h"
 
+// MFP mode written to SQWEN by rtc6_Initialize(), the RB2 pin filter is configured from the same value.
+// Build with RTCC_MFP_SQWEN=0 in the project macros to make MFP an alarm output; the timestamps then hold whole seconds.
+#ifndef RTCC_MFP_SQWEN
+#define RTCC_MFP_SQWEN              (1)                                       //  1 Hz square wave, alarm flags polled on every edge
+#endif
+
+// Battery backed SRAM allocation, offsets from the start of the 64 byte SRAM
+#define RTCC_SRAM_SIZE              (64)
+#define SRAM_TIMEZONE               (0x00)                                    //  TzConfig_t followed by a check byte
+#define SRAM_SUPERVISOR             (0x10)                                    //  SupervisorRecord_t followed by a check byte
+
+// ALMxMSK match modes, an alarm fires every time the selected fields match
+#define RTCC_ALARM_MATCH_SECONDS    (0x00)                                    //  Once a minute
+#define RTCC_ALARM_MATCH_MINUTES    (0x01)                                    //  Once an hour
+#define RTCC_ALARM_MATCH_HOURS      (0x02)                                    //  Once a day
+#define RTCC_ALARM_MATCH_WEEKDAY    (0x03)                                    //  Once a week
+#define RTCC_ALARM_MATCH_DATE       (0x04)                                    //  Once a month
+#define RTCC_ALARM_MATCH_FULL       (0x07)                                    //  Seconds, minutes, hour, weekday, date and month
+#define RTCC_ALARM_MATCH_VALID(m)   ((m) <= RTCC_ALARM_MATCH_DATE || (m) == RTCC_ALARM_MATCH_FULL)
+#define RTCC_ALARM_ACTIVE_HIGH      (true)                                    //  ALMPOL, level of MFP on a match
+
+// Results of rtc6_Initialize() and rtc6_PollStart()
+#define RTCC_INIT_READY             (0)
+#define RTCC_INIT_STARTING          (1)                                       //  Oscillator started, OSCRUN not set yet
+#define RTCC_INIT_FAILED            (2)
+
+// Chips that follow the primary for rtc6_VoteDateTime()
+#define RTCC_REDUNDANT_MAX          (2)
+
+// Register image of one alarm bank, ALMxSEC..ALMxMTH, built by rtc6_PrepareAlarm()
+#define RTCC_ALARM_IMAGE_SIZE       (6)
+
+typedef struct {
+    uint8_t reg[RTCC_ALARM_IMAGE_SIZE];
+} RtccAlarm_t;
+
+// State found by rtc6_CheckHealth()
+#define RTCC_HEALTH_PRESENT         (0x01)                                    //  The chip answered
+#define RTCC_HEALTH_OSC_RUNNING     (0x02)                                    //  OSCRUN set
+#define RTCC_HEALTH_CONFIGURED      (0x04)                                    //  ST, VBATEN and CONTROL as rtc6_Initialize() leaves them
+#define RTCC_HEALTH_TIME_VALID      (0x08)                                    //  Seconds..Year hold a calendar time
+#define RTCC_HEALTH_VBAT_EVENT      (0x10)                                    //  PWRFAIL set, main power was lost and the stamps at 0x18 are valid
+#define RTCC_HEALTH_ALARM0          (0x20)                                    //  ALM0EN set
+#define RTCC_HEALTH_ALARM1          (0x40)                                    //  ALM1EN set
+#define RTCC_HEALTH_WARM            (RTCC_HEALTH_PRESENT | RTCC_HEALTH_OSC_RUNNING | RTCC_HEALTH_CONFIGURED)
+
+// Last values read from the chip, see rtc6_Snapshot()
 typedef struct {
-    int sec, min, hr;
-    int year, month, date, day;
-} DateTime_t;
+    uint32_t time;                                                           // Seconds since 1970 from the last time read, 0 when invalid
+    uint8_t health;                                                          // RTCC_HEALTH_xxx from the last health check
+    uint8_t alarms;                                                          // RTCC_ALARMx bits from the last rtc6_ServiceAlarms()
+    uint8_t sequence;                                                        // Advances with every publish
+} RtccSnapshot_t;
+
+// An alarm as seen by the firmware
+typedef struct {
+    Timestamp_t time;                                                        // Wall clock at the MFP edge
+    LatencyEdge_t timing;                                                    // Edge, interrupt and main loop Timer1 values
+    uint8_t alarms;                                                          // RTCC_ALARMx bits found set
+} RtccAlarmEvent_t;
+
+// Alarms reported by rtc6_ServiceAlarms()
+#define RTCC_ALARM0                 (0x01)
+#define RTCC_ALARM1                 (0x02)
+
+// Operations carried by a batch, see rtc6_ExecuteBatch()
+#define RTCC_BATCH_SET_TIME         (0x01)
+#define RTCC_BATCH_SET_ALARM0       (0x02)
+#define RTCC_BATCH_SET_ALARM1       (0x04)
+#define RTCC_BATCH_ENABLE           (0x08)
+#define RTCC_BATCH_READ_BACK        (0x10)
+
+typedef struct {
+    uint8_t ops;                                                             // RTCC_BATCH_xxx flags
+    time_t time, alarm0, alarm1;
+    bool alarm0Enable, alarm1Enable;
+    time_t readBack;                                                         // Filled when RTCC_BATCH_READ_BACK is requested
+} RtccBatch_t;
 
 /**
    @Param
     none
    @Returns
+    RTCC_INIT_READY, RTCC_INIT_STARTING or RTCC_INIT_FAILED
+   @Description
+    Checks the chip with rtc6_CheckHealth(). A warm chip keeps CONTROL and
+    its alarm banks, the alarms it has enabled are armed again and a VBAT
+    event only clears PWRFAIL. Otherwise initializes all the Rtcc
+    registers and starts the oscillator; RTCC_INIT_STARTING then asks the
+    caller to call rtc6_PollStart() until it reports the result.
+   @Example
+    none
+ */
+uint8_t rtc6_Initialize(void);
+
+/**
+   @Param
     none
+   @Returns
+    RTCC_INIT_STARTING until OSCRUN is set, then RTCC_INIT_READY.
+    RTCC_INIT_FAILED after about 2 s without OSCRUN.
    @Description
-    Initializes all the Rtcc registers
+    Checks OSCRUN once without waiting. Once the oscillator runs, enables
+    the battery and clears PWRFAIL.
    @Example
+    while (rtc6_PollStart() == RTCC_INIT_STARTING)
+    {
+        // other main loop work
+    }
+ */
+uint8_t rtc6_PollStart(void);
+
+/**
+   @Param
+    none
+   @Returns
     none
+   @Description
+    Makes the next rtc_Application() pass check the alarm flags, as an RB2
+    edge does. For main loop code; interrupt routines set the flag
+    themselves.
+   @Example
+    rtc6_RequestService();
  */
-void rtc6_Initialize(void);
+void rtc6_RequestService(void);
 
 /**
    @Param
-    time structure, alarm polarity, mask value
+    none
    @Returns
+    RTCC_HEALTH_xxx flags
+   @Description
+    Reads registers 0x00..0x08 in one burst and classifies the chip
+   @Example
+    none
+ */
+uint8_t rtc6_CheckHealth(void);
+
+/**
+   @Param
     none
+   @Returns
+    RTCC_HEALTH_xxx flags found by the last rtc6_Initialize()
    @Description
-    Sets Alarm0 Time for user
+    Boot state of the chip, before the initialization changed it
    @Example
     none
  */
-void rtc6_SetAlarm0(struct tm tm_t, bool almpol, uint8_t mask);
+uint8_t rtc6_Health(void);
 
 /**
    @Param
-    time structure, alarm polarity, mask value
+    destination
    @Returns
     none
    @Description
-    Sets Alarm1 Time for user
+    Copies the last published time and status without touching the bus or
+    the interrupt enables. The main loop publishes into the idle half of a
+    double buffer and then flips a one byte index, so an interrupt always
+    copies a complete snapshot. Safe from interrupts and the main loop.
+   @Example
+    none
+ */
+void rtc6_Snapshot(RtccSnapshot_t *snapshot);
+
+/**
+   @Param
+    destination
+   @Returns
+    false when no alarm has fired since reset
+   @Description
+    Copies the record of the last alarm. The time comes from the Timer1
+    value CCP1 captured at the MFP edge, so no I2C read is involved.
    @Example
     none
  */
-void rtc6_SetAlarm1(struct tm tm_t, bool almpol, uint8_t mask);
+bool rtc6_LastAlarm(RtccAlarmEvent_t *event);
+
+/**
+   @Param
+    alarm date and time, alarm polarity, RTCC_ALARM_MATCH_xxx mode,
+    destination image
+   @Returns
+    false when the time or the match mode is out of range
+   @Description
+    Converts an alarm to the BCD register image once. Both banks share the
+    layout, so one image can be loaded into either alarm any number of times.
+   @Example
+    rtc6_PrepareAlarm(&dt, RTCC_ALARM_ACTIVE_HIGH, RTCC_ALARM_MATCH_FULL, &image);
+ */
+bool rtc6_PrepareAlarm(const DateTime_t *dt, bool almpol, uint8_t mask, RtccAlarm_t *alarm);
+
+/**
+   @Param
+    image from rtc6_PrepareAlarm()
+   @Returns
+    true when the write completed or is held for the next commit
+   @Description
+    Sets Alarm0 Time for user, a one shot alarm
+   @Example
+    none
+ */
+bool rtc6_SetAlarm0(const RtccAlarm_t *alarm);
+
+/**
+   @Param
+    image from rtc6_PrepareAlarm()
+   @Returns
+    true when the write completed or is held for the next commit
+   @Description
+    Sets Alarm1 Time for user, a one shot alarm
+   @Example
+    none
+ */
+bool rtc6_SetAlarm1(const RtccAlarm_t *alarm);
 
 /**
    @Param
     Timestamp
    @Returns
+    true when the clock reads back the time written
+   @Description
+    Sets the clock atomically: stops the oscillator and waits for OSCRUN
+    to clear, writes Seconds..Year in one burst with ST set, then reads the
+    block back. This is the only supported way to set the time.
+   @Example
     none
+ */
+bool rtc6_SetTime(time_t);
+
+/**
+   @Param
+    date and time, the weekday is written as given
+   @Returns
+    true when the clock reads back the time written
    @Description
-    Sets the time parameter in the register
+    Same as rtc6_SetTime() without the epoch conversion, the fields go to
+    the registers as they are
    @Example
     none
  */
-void rtc6_SetTime(time_t);
+bool rtc6_SetDateTime(const DateTime_t *dt);
 
 /**
    @Param
     none
    @Returns
-    long long timestamp
+    long long timestamp, 0 when the read failed or the registers do not
+    hold a calendar time
    @Description
     Gets timestamp from rtc registers
    @Example
@@ -108,6 +303,88 @@ void rtc6_SetTime(time_t);
  */
 time_t rtc6_GetTime(void);
 
+/**
+   @Param
+    destination date and time
+   @Returns
+    false when the read failed or the registers do not hold a calendar time
+   @Description
+    Reads Seconds..Year in one burst straight into the packed fields
+   @Example
+    none
+ */
+bool rtc6_GetDateTime(DateTime_t *dt);
+
+/**
+   @Param
+    device descriptor of another RTCC on the bus, see MCP7941X_DEVICE()
+   @Returns
+    false when RTCC_REDUNDANT_MAX chips are already added
+   @Description
+    Adds a chip that is set along with the primary by rtc6_SetDateTime()
+    and takes part in rtc6_VoteDateTime(). Alarms, SRAM and the MFP stay
+    on the primary, and the driver keeps no other state per chip. Every
+    MCP7941x answers at 0x6F, so each extra chip needs an address
+    translator or a bus switch outside the firmware that maps the address
+    in its descriptor onto it.
+   @Example
+    static const RegMapDevice_t backup = MCP7941X_DEVICE(0x6E);
+    rtc6_AddRedundant(&backup);
+ */
+bool rtc6_AddRedundant(const RegMapDevice_t *dev);
+
+/**
+   @Param
+    destination date and time
+   @Returns
+    number of chips that agree with the result, 0 when no majority exists
+   @Description
+    Reads Seconds..Year from the primary and every redundant chip, one burst
+    each, and returns the time held by the majority. Readings one second
+    apart count as equal, since the clocks can tick between the bursts.
+   @Example
+    none
+ */
+uint8_t rtc6_VoteDateTime(DateTime_t *dt);
+
+/**
+   @Param
+    batch of operations
+   @Returns
+    true when every transaction completed
+   @Description
+    Applies time, alarms and alarm enables in one pass, coalescing the
+    register writes into the fewest burst transactions, then optionally
+    reads the time back
+   @Example
+    none
+ */
+bool rtc6_ExecuteBatch(RtccBatch_t *batch);
+
+/**
+   @Param
+    SRAM offset, destination buffer, number of bytes
+   @Returns
+    true when the read completed
+   @Description
+    Reads from the battery backed SRAM in one burst
+   @Example
+    none
+ */
+bool rtc6_ReadSram(uint8_t offset, uint8_t *data, uint8_t length);
+
+/**
+   @Param
+    SRAM offset, source buffer, number of bytes
+   @Returns
+    true when the write completed
+   @Description
+    Writes to the battery backed SRAM in one burst
+   @Example
+    none
+ */
+bool rtc6_WriteSram(uint8_t offset, const uint8_t *data, uint8_t length);
+
 /**
    @Param
     none
@@ -132,6 +409,20 @@ void rtc_Application(void);
  */
 void rtc6_ClearAlarm0(void);
 
+/**
+   @Param
+    alarm 0 or 1, true to enable
+   @Returns
+    true when the ALMxEN write completed
+   @Description
+    Sets the enable of one alarm without touching the other. A disabled
+    alarm is no longer checked by rtc6_ServiceAlarms() and loses its
+    repeat; an enabled one is checked from then on.
+   @Example
+    rtc6_EnableAlarm(0, true);
+ */
+bool rtc6_EnableAlarm(uint8_t alarm, bool enable);
+
 /**
    @Param
     none
@@ -146,15 +437,59 @@ void rtc6_ClearAlarm1(void);
 
 /**
    @Param
+    alarm 0 or 1, first occurrence, RTCC_ALARM_MATCH_xxx mode
+   @Returns
+    true when the alarm was written and enabled
+   @Description
+    Programs an alarm that keeps firing each time the masked fields match,
+    e.g. RTCC_ALARM_MATCH_MINUTES with a first occurrence at xx:15:00 fires
+    at quarter past every hour. rtc6_ServiceAlarms() rearms it.
+   @Example
+    rtc6_SetRepeatingAlarm(1, first, RTCC_ALARM_MATCH_MINUTES);
+ */
+bool rtc6_SetRepeatingAlarm(uint8_t alarm, time_t first, uint8_t match);
+
+/**
+   @Param
+    none
+   @Returns
+    RTCC_ALARM0 and RTCC_ALARM1 bits for the alarms that fired
+   @Description
+    Follow-up of the 1 Hz interrupt. Reads both alarm flags in one burst
+    when an alarm is armed and clears the flag of each alarm that fired
+    with a single register write, which rearms a repeating alarm. A one
+    shot alarm is no longer checked after it fired.
+   @Example
     none
+ */
+uint8_t rtc6_ServiceAlarms(void);
+
+/**
+   @Param
+    Timer1 value at the edge
+   @Returns
+    none
+   @Description
+    Interrupt Routine for the 1 Hz square wave on MFP, registered for
+    PINEVENT_SQUARE_WAVE
+   @Example
+    none
+ */
+void Rtcc_External_Interrupt(uint16_t edge);
+
+/**
+   @Param
+    Timer1 value at the edge
    @Returns
     none
    @Description
-    Interrupt Routine for alarm match
+    Interrupt Routine for alarm match when MFP is an alarm output,
+    registered for PINEVENT_ALARM. Both routines keep the edge for the
+    record rtc6_LastAlarm() returns.
    @Example
     none
  */
-void Rtcc_External_Interrupt(void);
+void Rtcc_Alarm_Interrupt(uint16_t edge);
 
 #ifdef	__cplusplus
 }
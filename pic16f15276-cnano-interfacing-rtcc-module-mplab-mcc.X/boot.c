@@ -0,0 +1,155 @@
+/*
+ * File:   boot.c
+ *
+ * Start-up order matters more than start-up length: the RB2 interrupt is
+ * armed before anything touches the bus, the RTCC stage follows on the
+ * first main loop pass, and the console banner, which blocks on the UART
+ * at 9600 baud, comes last. Timer1 starts in SYSTEM_Initialize(), so
+ * systime_Millis() is close to the time since reset.
+ */
+
+/*
+ ***********************************************************
+ *                                                         *
+ *                  Include Header Files                   *
+ *                                                         *
+ ***********************************************************
+*/
+#include <xc.h>
+#include "boot.h"
+#include "application.h"
+#include "console.h"
+#include "latency.h"
+#include "trace.h"
+#include "mcc_generated_files/system/interrupt.h"
+#include "pinevent.h"
+#include "supervisor.h"
+#include "systime.h"
+#include "timestamp.h"
+#include "timezone.h"
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              User Defined Variables                     *
+ *                                                         *
+ ***********************************************************
+*/
+// Follows the SQWEN value rtc6_Initialize() writes
+static const PinEventConfig_t mfpConfig = {
+#if RTCC_MFP_SQWEN
+    PINEVENT_EDGE_RISING, PINEVENT_SQUARE_WAVE, PINEVENT_SQW_MIN_INTERVAL, 0    // One pulse a second, closer ones are noise
+#else
+    PINEVENT_EDGE_RISING, PINEVENT_ALARM, 0, 0                                  // MFP rises on a match, RTCC_ALARM_ACTIVE_HIGH
+#endif
+};
+
+static uint8_t bootStage;
+static uint32_t bootAlarmReady;
+static uint8_t bootClock;                                                    // RTCC_INIT_xxx of the RTCC stages
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              Static Function Declarations               *
+ *                                                         *
+ ***********************************************************
+*/
+static void boot_Banner(void);
+static void boot_ClockReady(void);
+
+/*
+ ***********************************************************
+ *                                                         *
+ *          User Defined Function Definitions              *
+ *                                                         *
+ ***********************************************************
+*/
+
+static void boot_Banner(void)
+{
+    console_PutString(" RTCC Example \n Please enter the input of your choice: \n");
+    console_PutString(" A - Setting the time \n B - Setting the alarm \n R - Repeating alarm \n C - Reading the current time \n D - Batch of operations \n S - Millisecond timestamp \n Z - Setting the time zone \n");
+#if INTERRUPT_STATS_ENABLE
+    console_PutString(" I - Interrupt statistics \n");
+#endif
+#if LATENCY_ENABLE
+    console_PutString(" L - Alarm path latency \n");
+#endif
+#if TRACE_ENABLE
+    console_PutString(" T - I2C and UART trace \n");
+#endif
+    console_PutString("\n");
+    supervisor_Report();
+    if (bootClock == RTCC_INIT_FAILED)
+    {
+        console_PutString(" The RTCC oscillator did not start \n");
+    }
+    if (rtc6_Health() & RTCC_HEALTH_VBAT_EVENT)
+    {
+        console_PutString(" Main power was lost, the RTCC ran from its battery \n");
+    }
+    if (!(rtc6_Health() & RTCC_HEALTH_TIME_VALID))
+    {
+        console_PutString(" The RTCC does not hold a valid time, use option A \n");
+    }
+    console_PutString(" Alarm path ready after ");
+    console_PutUnsigned(bootAlarmReady, 0);
+    console_PutString(" ms \n\n");
+}
+
+// Timestamp base and the first alarm check, once the oscillator runs or was given up
+static void boot_ClockReady(void)
+{
+    timestamp_Initialize(rtc6_GetTime());
+    bootAlarmReady = systime_Millis();
+    rtc6_RequestService();                                                   // A flag set while powered off is serviced on this pass, not at the next tick
+}
+
+void boot_Initialize(void)
+{
+    bootStage = BOOT_RTCC;
+    bootAlarmReady = 0;
+    pinevent_SetHandler(PINEVENT_SQUARE_WAVE, Rtcc_External_Interrupt);
+    pinevent_SetHandler(PINEVENT_ALARM, Rtcc_Alarm_Interrupt);
+    pinevent_Initialize(&mfpConfig);
+}
+
+bool boot_Step(void)
+{
+    switch (bootStage)
+    {
+        case BOOT_RTCC:
+            bootClock = rtc6_Initialize();                                   // One transaction on a warm chip
+            if (bootClock != RTCC_INIT_STARTING)
+            {
+                boot_ClockReady();
+                bootStage = BOOT_OSCILLATOR;                                 // Nothing to wait for
+            }
+            break;
+        case BOOT_OSCILLATOR:
+            bootClock = rtc6_PollStart();
+            if (bootClock == RTCC_INIT_STARTING)
+            {
+                return false;                                                // Polled again on the next pass
+            }
+            boot_ClockReady();
+            break;
+        case BOOT_RECORDS:
+            supervisor_Record();
+            timezone_Initialize();
+            break;
+        case BOOT_BANNER:
+            boot_Banner();
+            break;
+        default:
+            return true;
+    }
+    bootStage++;
+    return false;
+}
+
+uint32_t boot_AlarmReadyMs(void)
+{
+    return bootAlarmReady;
+}
@@ -0,0 +1,97 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   
+ * Author: 
+ * Comments:
+ * Revision history: 
+ */
+
+
+/* 
+ * File:   boot.h
+ * Author: 
+ * Comments: Staged start-up run from the main loop after the alarm interrupt is armed
+ * Revision history: 
+ */
+
+#ifndef BOOT_H
+#define	BOOT_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// include files
+#include <stdint.h>
+#include <stdbool.h>
+
+// Start-up stages, one runs per main loop pass
+#define BOOT_RTCC                   (0)                                       //  Health check or initialization
+#define BOOT_OSCILLATOR             (1)                                       //  Polls OSCRUN on a cold chip, then the timestamp base
+#define BOOT_RECORDS                (2)                                       //  Reset record and time zone from the SRAM
+#define BOOT_BANNER                 (3)                                       //  Console banner and boot report
+#define BOOT_DONE                   (4)
+
+/**
+   @Param
+    none
+   @Returns
+    none
+   @Description
+    Registers the MFP handlers and arms the RB2 interrupt. Call right after
+    SYSTEM_Initialize(), before the interrupts are enabled.
+   @Example
+    none
+ */
+void boot_Initialize(void);
+
+/**
+   @Param
+    none
+   @Returns
+    true once every stage has run
+   @Description
+    Runs the next start-up stage. Called from the main loop so that alarm
+    events are handled between the stages.
+   @Example
+    none
+ */
+bool boot_Step(void);
+
+/**
+   @Param
+    none
+   @Returns
+    milliseconds from reset until alarms could be serviced, 0 before that
+   @Description
+    Time to first alarm ready, printed with the banner
+   @Example
+    none
+ */
+uint32_t boot_AlarmReadyMs(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,406 @@
+/*
+ * File:   command.c
+ *
+ * Batch command protocols: one UART frame carries a list of RTCC
+ * operations which are applied through a single rtc6_ExecuteBatch() call.
+ */
+
+/*
+ ***********************************************************
+ *                                                         *
+ *                  Include Header Files                   *
+ *                                                         *
+ ***********************************************************
+*/
+#include <xc.h>
+#include "command.h"
+#include "console.h"
+#include "timestamp.h"
+#include "supervisor.h"
+
+#define BATCH_FRAME_MAX             (24)                                      //  Longest binary body: every opcode once
+#define EPOCH_DIGITS_MAX            (10)                                      //  uint32 epoch fits in ten digits
+#define IS_DIGIT(c)                 ((uint8_t)((c) - '0') <= 9)
+#define TZ_FIELDS                   (10)                                      //  offset, dst and two four-field rules
+#define IS_TERMINATOR(c)            ((c) == '\r' || (c) == '\n')
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              Static Function Declarations               *
+ *                                                         *
+ ***********************************************************
+*/
+static uint8_t command_ReadByte(void);
+static bool command_AddDigit(uint32_t *value, uint8_t rxByte);
+static uint32_t command_GetLe32(const uint8_t *data);
+static int8_t command_ReadIntegers(int16_t *values, uint8_t count);
+static bool command_StoreToken(RtccBatch_t *batch, uint8_t token, uint32_t value, uint8_t digits);
+
+/*
+ ***********************************************************
+ *                                                         *
+ *          User Defined Function Definitions              *
+ *                                                         *
+ ***********************************************************
+*/
+
+static uint8_t command_ReadByte(void)
+{
+    while(!EUSART1_IsRxReady())
+    {
+        supervisor_Wait();                                                   // The prompt may wait on the user for longer than the watchdog period
+    }
+    return EUSART1_Read();
+}
+
+// Appends one decimal digit, false if the result no longer fits in 32 bits
+static bool command_AddDigit(uint32_t *value, uint8_t rxByte)
+{
+    uint8_t digit = (uint8_t)(rxByte - '0');
+    if (*value > (UINT32_MAX - digit) / 10)
+    {
+        return false;
+    }
+    *value = *value * 10 + digit;
+    return true;
+}
+
+void command_EpochReset(EpochParser_t *parser)
+{
+    parser->value = 0;
+    parser->digits = 0;
+    parser->error = false;
+}
+
+uint8_t command_EpochFeed(EpochParser_t *parser, uint8_t rxByte)
+{
+    uint8_t status = COMMAND_EPOCH_BUSY;
+
+    if (IS_DIGIT(rxByte))
+    {
+        parser->digits++;
+        if (!parser->error && !command_AddDigit(&parser->value, rxByte))
+        {
+            parser->error = true;
+        }
+    }
+    else if (IS_TERMINATOR(rxByte))
+    {
+        if (parser->digits != 0 || parser->error)
+        {
+            status = (!parser->error && COMMAND_EPOCH_VALID(parser->value))
+                        ? COMMAND_EPOCH_DONE : COMMAND_EPOCH_INVALID;
+        }
+    }
+    else
+    {
+        parser->error = true;                                                // Keep consuming until the terminator
+    }
+    return status;
+}
+
+bool command_ReadEpoch(time_t *epoch)
+{
+    EpochParser_t parser;
+    uint8_t status;
+
+    command_EpochReset(&parser);
+    do
+    {
+        status = command_EpochFeed(&parser, command_ReadByte());
+    } while (status == COMMAND_EPOCH_BUSY);
+
+    *epoch = (time_t)parser.value;
+    return (status == COMMAND_EPOCH_DONE);
+}
+
+// Reads up to count signed integers separated by spaces, ended by CR or LF; -1 on malformed input
+static int8_t command_ReadIntegers(int16_t *values, uint8_t count)
+{
+    uint8_t rxByte;
+    uint8_t found = 0;
+    uint8_t digits = 0;
+    uint32_t value = 0;
+    bool negative = false;
+    bool sign = false;
+    bool valid = true;
+    bool started = false;
+
+    do
+    {
+        rxByte = command_ReadByte();
+        started = started || !IS_TERMINATOR(rxByte);                        // Skip the LF of a previous CR LF
+        if (IS_DIGIT(rxByte))
+        {
+            valid = valid && command_AddDigit(&value, rxByte) && value <= INT16_MAX;
+            digits++;
+        }
+        else if ((rxByte == '-' || rxByte == '+') && digits == 0 && !sign)
+        {
+            negative = (rxByte == '-');
+            sign = true;
+        }
+        else if (rxByte == ' ' || rxByte == ',' || IS_TERMINATOR(rxByte))
+        {
+            valid = valid && !(sign && digits == 0);
+            if (digits != 0)
+            {
+                valid = valid && (found < count);
+                if (valid)
+                {
+                    values[found++] = negative ? -(int16_t)value : (int16_t)value;
+                }
+            }
+            digits = 0;
+            value = 0;
+            negative = false;
+            sign = false;
+        }
+        else
+        {
+            valid = false;
+        }
+    } while (!IS_TERMINATOR(rxByte) || !started);
+
+    return valid ? (int8_t)found : -1;
+}
+
+static uint32_t command_GetLe32(const uint8_t *data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+// Records one parsed text token into the batch, false if it is malformed
+static bool command_StoreToken(RtccBatch_t *batch, uint8_t token, uint32_t value, uint8_t digits)
+{
+    bool retStatus = true;
+
+    switch(token)
+    {
+        case 0:                                                              // Nothing pending between separators
+            retStatus = (digits == 0);
+            break;
+        case 'T':
+            batch->ops |= RTCC_BATCH_SET_TIME;
+            batch->time = (time_t)value;
+            retStatus = COMMAND_EPOCH_VALID(value);
+            break;
+        case 'A':
+            batch->ops |= RTCC_BATCH_SET_ALARM0;
+            batch->alarm0 = (time_t)value;
+            retStatus = COMMAND_EPOCH_VALID(value);
+            break;
+        case 'B':
+            batch->ops |= RTCC_BATCH_SET_ALARM1;
+            batch->alarm1 = (time_t)value;
+            retStatus = COMMAND_EPOCH_VALID(value);
+            break;
+        case 'E':                                                            // Two digits: alarm0 then alarm1
+            batch->ops |= RTCC_BATCH_ENABLE;
+            batch->alarm0Enable = (value / 10) != 0;
+            batch->alarm1Enable = (value % 10) != 0;
+            retStatus = (digits == 2);
+            break;
+        case 'R':
+            batch->ops |= RTCC_BATCH_READ_BACK;
+            retStatus = (digits == 0);
+            break;
+        default:
+            retStatus = false;
+            break;
+    }
+    return retStatus;
+}
+
+void command_TextBatch(void)
+{
+    RtccBatch_t batch;
+    uint8_t rxByte;
+    uint8_t token = 0;
+    uint8_t digits = 0;
+    uint32_t value = 0;
+    bool valid = true;
+    bool started = false;
+
+    memset(&batch, 0, sizeof (batch));
+    do
+    {
+        rxByte = command_ReadByte();
+        started = started || !IS_TERMINATOR(rxByte);                        // Skip the LF of a previous CR LF
+        if (IS_DIGIT(rxByte))
+        {
+            valid = valid && (token != 0) && (++digits <= EPOCH_DIGITS_MAX) && command_AddDigit(&value, rxByte);
+        }
+        else
+        {
+            valid = valid && command_StoreToken(&batch, token, value, digits);   // Any non-digit closes the pending token
+            token = (rxByte >= 'A' && rxByte <= 'Z') ? rxByte : 0;
+            valid = valid && (token != 0 || rxByte == ' ' || rxByte == ';' || IS_TERMINATOR(rxByte));
+            digits = 0;
+            value = 0;
+        }
+    } while (!IS_TERMINATOR(rxByte) || !started);
+
+    if (!valid || batch.ops == 0)
+    {
+        console_PutString("\n\t\r Batch rejected \n\n");
+    }
+    else if (!rtc6_ExecuteBatch(&batch))
+    {
+        console_PutString("\n\t\r Batch failed on the I2C bus \n\n");
+    }
+    else
+    {
+        if (batch.ops & RTCC_BATCH_SET_TIME)
+        {
+            timestamp_Sync(batch.time);
+        }
+        console_PutString("\n\t\r Batch done, operations : 0x");
+        console_PutHex(batch.ops);
+        console_PutString(" \n");
+        if (batch.ops & RTCC_BATCH_READ_BACK)
+        {
+            console_PutString("\n\t\r Seconds since the Epoch: ");
+            console_PutUnsigned((uint32_t)batch.readBack, 0);
+            console_PutString("\n");
+        }
+        console_PutString("\n");
+    }
+}
+
+void command_BinaryBatch(void)
+{
+    RtccBatch_t batch;
+    uint8_t frame[BATCH_FRAME_MAX];
+    uint8_t length;
+    uint8_t index;
+    uint8_t rxByte;
+    uint8_t checksum = 0;
+    uint8_t status = COMMAND_STATUS_OK;
+
+    memset(&batch, 0, sizeof (batch));
+    length = command_ReadByte();
+    for (index = 0; index < length; index++)                                 // Always drain the frame so the stream stays in sync
+    {
+        rxByte = command_ReadByte();
+        if (index < BATCH_FRAME_MAX)
+        {
+            frame[index] = rxByte;
+        }
+        checksum ^= rxByte;
+    }
+    if (length > BATCH_FRAME_MAX || command_ReadByte() != checksum)
+    {
+        status = COMMAND_STATUS_FRAME;
+    }
+
+    index = 0;
+    while (status == COMMAND_STATUS_OK && index < length)
+    {
+        uint8_t opcode = frame[index++];
+        uint8_t payload = (opcode == COMMAND_OP_ENABLE) ? 1 : ((opcode == COMMAND_OP_READ_BACK) ? 0 : 4);
+
+        if (opcode < COMMAND_OP_SET_TIME || opcode > COMMAND_OP_READ_BACK)
+        {
+            status = COMMAND_STATUS_OPCODE;                                  // Before the payload, its length depends on the opcode
+            break;
+        }
+        if ((uint8_t)(length - index) < payload)
+        {
+            status = COMMAND_STATUS_OPCODE;
+            break;
+        }
+        if (payload == 4 && !COMMAND_EPOCH_VALID(command_GetLe32(&frame[index])))
+        {
+            status = COMMAND_STATUS_RANGE;                                   // The clock only holds 2000..2099
+            break;
+        }
+        switch(opcode)
+        {
+            case COMMAND_OP_SET_TIME:
+                batch.ops |= RTCC_BATCH_SET_TIME;
+                batch.time = (time_t)command_GetLe32(&frame[index]);
+                break;
+            case COMMAND_OP_SET_ALARM0:
+                batch.ops |= RTCC_BATCH_SET_ALARM0;
+                batch.alarm0 = (time_t)command_GetLe32(&frame[index]);
+                break;
+            case COMMAND_OP_SET_ALARM1:
+                batch.ops |= RTCC_BATCH_SET_ALARM1;
+                batch.alarm1 = (time_t)command_GetLe32(&frame[index]);
+                break;
+            case COMMAND_OP_ENABLE:
+                batch.ops |= RTCC_BATCH_ENABLE;
+                batch.alarm0Enable = (frame[index] & 0x01) != 0;
+                batch.alarm1Enable = (frame[index] & 0x02) != 0;
+                break;
+            case COMMAND_OP_READ_BACK:
+                batch.ops |= RTCC_BATCH_READ_BACK;
+                break;
+            default:
+                status = COMMAND_STATUS_OPCODE;
+                break;
+        }
+        index += payload;
+    }
+
+    if (status == COMMAND_STATUS_OK && !rtc6_ExecuteBatch(&batch))
+    {
+        status = COMMAND_STATUS_BUS;
+    }
+
+    // Response: SOF, LEN, status, optional epoch, XOR checksum of status and epoch
+    length = (status == COMMAND_STATUS_OK && (batch.ops & RTCC_BATCH_READ_BACK)) ? 5 : 1;
+    frame[0] = status;
+    frame[1] = (uint8_t)((uint32_t)batch.readBack);
+    frame[2] = (uint8_t)((uint32_t)batch.readBack >> 8);
+    frame[3] = (uint8_t)((uint32_t)batch.readBack >> 16);
+    frame[4] = (uint8_t)((uint32_t)batch.readBack >> 24);
+    checksum = 0;
+    console_PutChar(COMMAND_BATCH_SOF);
+    console_PutChar((char)length);
+    for (index = 0; index < length; index++)
+    {
+        checksum ^= frame[index];
+    }
+    EUSART1_WriteBuffer(frame, length);
+    console_PutChar((char)checksum);
+}
+
+void command_TimeZone(void)
+{
+    TzConfig_t config;
+    int16_t values[TZ_FIELDS];
+    int8_t found = command_ReadIntegers(values, TZ_FIELDS);
+
+    memset(&config, 0, sizeof (config));
+    if (found == 1 || found == TZ_FIELDS)
+    {
+        config.offset = values[0];
+        if (found == TZ_FIELDS)
+        {
+            config.dstDelta = values[1];
+            config.start.month = (uint8_t)values[2];
+            config.start.week = (uint8_t)values[3];
+            config.start.wday = (uint8_t)values[4];
+            config.start.minute = (uint16_t)values[5];
+            config.end.month = (uint8_t)values[6];
+            config.end.week = (uint8_t)values[7];
+            config.end.wday = (uint8_t)values[8];
+            config.end.minute = (uint16_t)values[9];
+        }
+    }
+    if ((found == 1 || found == TZ_FIELDS) && timezone_Configure(&config))
+    {
+        console_PutString("\n\t\r Time zone set, UTC offset : ");
+        console_PutSigned(config.offset);
+        console_PutString(" min, DST : ");
+        console_PutSigned(config.dstDelta);
+        console_PutString(" min \n\n");
+    }
+    else
+    {
+        console_PutString("\n\t\r Time zone rejected \n\n");
+    }
+}
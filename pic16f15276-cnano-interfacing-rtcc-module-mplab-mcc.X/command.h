@@ -0,0 +1,156 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   command.h
+ * Author: 
+ * Comments: Batch command protocols (text and binary) for the RTCC console
+ * Revision history: 
+ */
+
+#ifndef COMMAND_H
+#define	COMMAND_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// include files
+#include <stdint.h>
+#include <stdbool.h>
+#include "application.h"
+#include "timezone.h"
+#include "datetime.h"
+
+#define COMMAND_EPOCH_VALID(v)      DATETIME_EPOCH_VALID(v)                   //  2000..2099, the years the clock can hold
+
+#define COMMAND_BATCH_SOF           (0x01)                                    //  Start of a binary batch frame
+
+// Binary batch opcodes, each followed by its payload
+#define COMMAND_OP_SET_TIME         (0x01)                                    //  4 byte little-endian epoch
+#define COMMAND_OP_SET_ALARM0       (0x02)                                    //  4 byte little-endian epoch
+#define COMMAND_OP_SET_ALARM1       (0x03)                                    //  4 byte little-endian epoch
+#define COMMAND_OP_ENABLE           (0x04)                                    //  1 byte, bit0 = alarm0, bit1 = alarm1
+#define COMMAND_OP_READ_BACK        (0x05)                                    //  no payload
+
+// Binary batch response status
+#define COMMAND_STATUS_OK           (0x00)
+#define COMMAND_STATUS_FRAME        (0x01)                                    //  Length or checksum error
+#define COMMAND_STATUS_OPCODE       (0x02)                                    //  Unknown opcode or truncated payload
+#define COMMAND_STATUS_BUS          (0x03)                                    //  I2C transaction failed
+#define COMMAND_STATUS_RANGE        (0x04)                                    //  Epoch outside 2000..2099
+
+// Streaming epoch parser states
+#define COMMAND_EPOCH_BUSY          (0)                                       //  More input expected
+#define COMMAND_EPOCH_DONE          (1)                                       //  Terminated, value is a valid epoch
+#define COMMAND_EPOCH_INVALID       (2)                                       //  Terminated, bad digit, overflow or out of range
+
+typedef struct {
+    uint32_t value;
+    uint8_t digits;
+    bool error;
+} EpochParser_t;
+
+/**
+   @Param
+    parser
+   @Returns
+    none
+   @Description
+    Prepares the parser for a new epoch
+   @Example
+    none
+ */
+void command_EpochReset(EpochParser_t *parser);
+
+/**
+   @Param
+    parser, received byte
+   @Returns
+    COMMAND_EPOCH_BUSY, COMMAND_EPOCH_DONE or COMMAND_EPOCH_INVALID
+   @Description
+    Accumulates one received byte into a 32-bit epoch. CR or LF ends the
+    number; terminators before the first digit are skipped so a CR LF pair
+    never yields an empty entry. The value must lie in 2000..2099.
+   @Example
+    none
+ */
+uint8_t command_EpochFeed(EpochParser_t *parser, uint8_t rxByte);
+
+/**
+   @Param
+    destination timestamp
+   @Returns
+    true when a valid epoch was received
+   @Description
+    Blocks until an epoch ended by CR or LF has been received
+   @Example
+    none
+ */
+bool command_ReadEpoch(time_t *epoch);
+
+/**
+   @Param
+    none
+   @Returns
+    none
+   @Description
+    Reads a text batch such as "T1700000000 A1700000060 E10 R" ended by
+    CR or LF, executes it in one pass and prints one aggregated response
+   @Example
+    none
+ */
+void command_TextBatch(void);
+
+/**
+   @Param
+    none
+   @Returns
+    none
+   @Description
+    Reads the rest of a binary batch frame whose COMMAND_BATCH_SOF byte was
+    already consumed: LEN, LEN bytes of opcodes with payload, XOR checksum
+    of those bytes. Replies SOF, LEN, status, [epoch], checksum.
+   @Example
+    none
+ */
+void command_BinaryBatch(void);
+
+/**
+   @Param
+    none
+   @Returns
+    none
+   @Description
+    Reads "offset [dst sm sw sd st em ew ed et]" ended by CR or LF and
+    configures the time zone: offset and dst in minutes, sm/em month,
+    sw/ew week (5 = last), sd/ed weekday (0 = Sunday), st/et minute of the
+    local day. A lone offset disables DST.
+   @Example
+    "60 60 3 5 0 120 10 5 0 180" is Central European Time
+ */
+void command_TimeZone(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif
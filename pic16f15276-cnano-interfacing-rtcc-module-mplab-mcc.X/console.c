@@ -0,0 +1,194 @@
+/*
+ * File:   console.c
+ *
+ * Table driven replacement for the printf conversions used by the
+ * application. Numbers are converted by subtracting powers of ten (no
+ * division on the 8-bit core) into a small chunk which is then copied into
+ * the EUSART1 transmit buffer in one go.
+ */
+
+/*
+ ***********************************************************
+ *                                                         *
+ *                  Include Header Files                   *
+ *                                                         *
+ ***********************************************************
+*/
+#include <xc.h>
+#include <string.h>
+#include "console.h"
+#include "timezone.h"
+
+#define DIGITS_MAX                  (10)                                      //  uint32 has at most ten decimal digits
+#define DATETIME_LENGTH             (19)                                      //  "YYYY-MM-DD HH:MM:SS"
+#define ISO8601_LENGTH              (24)                                      //  "YYYY-MM-DDTHH:MM:SS.mmmZ"
+
+typedef struct {
+    uint8_t width;
+    char separator;                                                          // Character written after the field, 0 for none
+} field_t;
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              User Defined Variables                     *
+ *                                                         *
+ ***********************************************************
+*/
+static const uint32_t powersOfTen[DIGITS_MAX] = {
+    1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL,
+    10000UL, 1000UL, 100UL, 10UL, 1UL
+};
+
+static const field_t dateTimeLayout[6] = {
+    {4, '-'}, {2, '-'}, {2, ' '}, {2, ':'}, {2, ':'}, {2, 0}
+};
+
+static const field_t iso8601Layout[6] = {
+    {4, '-'}, {2, '-'}, {2, 'T'}, {2, ':'}, {2, ':'}, {2, '.'}
+};
+
+static const char hexDigits[16] = "0123456789ABCDEF";
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              Static Function Declarations               *
+ *                                                         *
+ ***********************************************************
+*/
+static uint8_t console_FormatUnsigned(char *buffer, uint32_t value, uint8_t width);
+static uint32_t console_Clip(uint32_t value, uint8_t width);
+static uint8_t console_FormatFields(char *buffer, const struct tm *tm_t, const field_t *layout);
+
+/*
+ ***********************************************************
+ *                                                         *
+ *          User Defined Function Definitions              *
+ *                                                         *
+ ***********************************************************
+*/
+
+// Renders the six calendar fields following a layout table, each field clipped to its width
+static uint8_t console_FormatFields(char *buffer, const struct tm *tm_t, const field_t *layout)
+{
+    uint32_t fields[6];
+    uint8_t index;
+    uint8_t length = 0;
+
+    fields[0] = (uint32_t)(tm_t->tm_year + 1900);
+    fields[1] = (uint32_t)(tm_t->tm_mon + 1);                              // time.h gives January as zero
+    fields[2] = (uint32_t)tm_t->tm_mday;
+    fields[3] = (uint32_t)tm_t->tm_hour;
+    fields[4] = (uint32_t)tm_t->tm_min;
+    fields[5] = (uint32_t)tm_t->tm_sec;
+
+    for (index = 0; index < 6; index++)
+    {
+        length += console_FormatUnsigned(&buffer[length], console_Clip(fields[index], layout[index].width), layout[index].width);
+        if (layout[index].separator)
+        {
+            buffer[length++] = layout[index].separator;
+        }
+    }
+    return length;
+}
+
+// Drops the digits above width, the same as value % 10^width but by subtraction
+static uint32_t console_Clip(uint32_t value, uint8_t width)
+{
+    uint8_t position;
+
+    for (position = 0; position + width < DIGITS_MAX; position++)
+    {
+        while (value >= powersOfTen[position])
+        {
+            value -= powersOfTen[position];
+        }
+    }
+    return value;
+}
+
+// Writes value into buffer with at least width digits and returns the number of characters
+static uint8_t console_FormatUnsigned(char *buffer, uint32_t value, uint8_t width)
+{
+    uint8_t position;
+    uint8_t length = 0;
+    char digit;
+
+    for (position = 0; position < DIGITS_MAX; position++)
+    {
+        digit = '0';
+        while (value >= powersOfTen[position])
+        {
+            value -= powersOfTen[position];
+            digit++;
+        }
+        if (length != 0 || digit != '0' || position >= DIGITS_MAX - 1 || DIGITS_MAX - position <= width)
+        {
+            buffer[length++] = digit;
+        }
+    }
+    return length;
+}
+
+void console_PutChar(char character)
+{
+    EUSART1_Write((uint8_t)character);
+}
+
+void console_PutString(const char *text)
+{
+    EUSART1_WriteBuffer((const uint8_t *)text, (uint8_t)strlen(text));
+}
+
+void console_PutUnsigned(uint32_t value, uint8_t width)
+{
+    char buffer[DIGITS_MAX];
+    EUSART1_WriteBuffer((const uint8_t *)buffer, console_FormatUnsigned(buffer, value, width));
+}
+
+void console_PutSigned(int32_t value)
+{
+    char buffer[DIGITS_MAX + 1];
+    uint8_t length = 0;
+
+    if (value < 0)
+    {
+        buffer[length++] = '-';
+    }
+    length += console_FormatUnsigned(&buffer[length], (value < 0) ? 0UL - (uint32_t)value : (uint32_t)value, 0);
+    EUSART1_WriteBuffer((const uint8_t *)buffer, length);
+}
+
+void console_PutHex(uint8_t value)
+{
+    char buffer[2];
+    buffer[0] = hexDigits[value >> 4];
+    buffer[1] = hexDigits[value & 0x0F];
+    EUSART1_WriteBuffer((const uint8_t *)buffer, 2);
+}
+
+void console_PutDateTime(const struct tm *tm_t)
+{
+    char buffer[DATETIME_LENGTH];
+    EUSART1_WriteBuffer((const uint8_t *)buffer, console_FormatFields(buffer, tm_t, dateTimeLayout));
+}
+
+uint8_t console_FormatIso8601(char *buffer, const Timestamp_t *ts)
+{
+    struct tm tm_t;
+    uint8_t length;
+
+    timezone_CivilFromEpoch(ts->seconds, &tm_t);
+    length = console_FormatFields(buffer, &tm_t, iso8601Layout);
+    length += console_FormatUnsigned(&buffer[length], console_Clip(ts->millis, 3), 3);
+    buffer[length++] = 'Z';
+    return length;
+}
+
+void console_PutIso8601(const Timestamp_t *ts)
+{
+    char buffer[ISO8601_LENGTH];
+    EUSART1_WriteBuffer((const uint8_t *)buffer, console_FormatIso8601(buffer, ts));
+}
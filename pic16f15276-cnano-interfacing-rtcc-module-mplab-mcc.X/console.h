@@ -0,0 +1,143 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   console.h
+ * Author: 
+ * Comments: Minimal console formatter writing into the EUSART1 transmit buffer
+ * Revision history: 
+ */
+
+#ifndef CONSOLE_H
+#define	CONSOLE_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// include files
+#include <time.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "mcc_generated_files/uart/eusart1.h"
+#include "timestamp.h"
+
+/**
+   @Param
+    character
+   @Returns
+    none
+   @Description
+    Queues one character for transmission
+   @Example
+    none
+ */
+void console_PutChar(char character);
+
+/**
+   @Param
+    NUL terminated string
+   @Returns
+    none
+   @Description
+    Queues a fixed string for transmission
+   @Example
+    console_PutString("\n\t\r Alarm Time is Set \n\n");
+ */
+void console_PutString(const char *text);
+
+/**
+   @Param
+    value, minimum number of digits (zero padded, 0 for none)
+   @Returns
+    none
+   @Description
+    Queues an unsigned decimal number, replaces printf("%0*lu")
+   @Example
+    console_PutUnsigned(year, 4);
+ */
+void console_PutUnsigned(uint32_t value, uint8_t width);
+
+/**
+   @Param
+    value
+   @Returns
+    none
+   @Description
+    Queues a signed decimal number, replaces printf("%ld")
+   @Example
+    none
+ */
+void console_PutSigned(int32_t value);
+
+/**
+   @Param
+    value
+   @Returns
+    none
+   @Description
+    Queues a byte as two upper case hexadecimal digits, replaces printf("%02X")
+   @Example
+    none
+ */
+void console_PutHex(uint8_t value);
+
+/**
+   @Param
+    time structure
+   @Returns
+    none
+   @Description
+    Queues the time as "YYYY-MM-DD HH:MM:SS" in one chunk
+   @Example
+    none
+ */
+void console_PutDateTime(const struct tm *tm_t);
+
+/**
+   @Param
+    destination buffer of at least 24 characters, timestamp
+   @Returns
+    number of characters written (no terminating NUL)
+   @Description
+    Renders "YYYY-MM-DDTHH:MM:SS.mmmZ" for event logs
+   @Example
+    none
+ */
+uint8_t console_FormatIso8601(char *buffer, const Timestamp_t *ts);
+
+/**
+   @Param
+    timestamp
+   @Returns
+    none
+   @Description
+    Queues the ISO-8601 rendering of the timestamp in one chunk
+   @Example
+    none
+ */
+void console_PutIso8601(const Timestamp_t *ts);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif
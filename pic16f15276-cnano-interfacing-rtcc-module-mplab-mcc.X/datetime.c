@@ -0,0 +1,124 @@
+/*
+ * File:   datetime.c
+ *
+ * Calendar arithmetic for 2000..2099, the range of the two year digits of
+ * the RTCC. Within it every fourth year is a leap year, so the date split
+ * needs no division by 100 or 400 and no libc call.
+ */
+
+/*
+ ***********************************************************
+ *                                                         *
+ *                  Include Header Files                   *
+ *                                                         *
+ ***********************************************************
+*/
+#include <xc.h>
+#include <string.h>
+#include "datetime.h"
+
+#define SECONDS_PER_DAY             (86400UL)
+#define DAYS_TO_2000                (10957U)                                  //  1970-01-01 to 2000-01-01
+#define DAYS_PER_4_YEARS            (1461U)
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              User Defined Variables                     *
+ *                                                         *
+ ***********************************************************
+*/
+static const uint16_t daysBeforeMonth[13] = {
+    0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365
+};
+
+/*
+ ***********************************************************
+ *                                                         *
+ *          User Defined Function Definitions              *
+ *                                                         *
+ ***********************************************************
+*/
+
+uint16_t datetime_DaysFromCivil(uint8_t year, uint8_t month, uint8_t day)
+{
+    uint16_t days = DAYS_TO_2000 + (uint16_t)year * 365 + (year + 3) / 4;   // 2000 is a leap year, 2100 is out of range
+    days += daysBeforeMonth[month - 1] + day - 1;
+    if ((year & 0x03) == 0 && month > 2)
+    {
+        days++;
+    }
+    return days;
+}
+
+void datetime_FromEpoch(uint32_t epoch, DateTime_t *dt)
+{
+    uint32_t seconds = epoch % SECONDS_PER_DAY;
+    uint16_t days = (uint16_t)(epoch / SECONDS_PER_DAY);
+    uint16_t remaining;
+    uint8_t month;
+    uint8_t leap;
+
+    dt->wday = (uint8_t)((days + 4) % 7 + 1);                               // 1970-01-01 was a Thursday
+    dt->hour = (uint8_t)(seconds / 3600);
+    seconds %= 3600;
+    dt->min = (uint8_t)(seconds / 60);
+    dt->sec = (uint8_t)(seconds % 60);
+
+    remaining = (days > DAYS_TO_2000) ? days - DAYS_TO_2000 : 0;
+    dt->year = (uint8_t)(4 * (remaining / DAYS_PER_4_YEARS));
+    remaining %= DAYS_PER_4_YEARS;
+    if (remaining >= 366)                                                    // First year of each cycle is the leap year
+    {
+        remaining -= 366;
+        dt->year += (uint8_t)(1 + remaining / 365);
+        remaining %= 365;
+    }
+    leap = ((dt->year & 0x03) == 0);
+
+    for (month = 11; month > 0; month--)
+    {
+        if (remaining >= daysBeforeMonth[month] + (leap && month >= 2))
+        {
+            break;
+        }
+    }
+    dt->month = month + 1;
+    dt->mday = (uint8_t)(remaining - daysBeforeMonth[month] - (leap && month >= 2)) + 1;
+}
+
+uint32_t datetime_ToEpoch(const DateTime_t *dt)
+{
+    return (uint32_t)datetime_DaysFromCivil(dt->year, dt->month, dt->mday) * SECONDS_PER_DAY
+           + (uint32_t)dt->hour * 3600 + (uint16_t)dt->min * 60 + dt->sec;
+}
+
+bool datetime_IsValid(const DateTime_t *dt)
+{
+    uint8_t monthLength;
+
+    if (dt->sec > 59 || dt->min > 59 || dt->hour > 23 || dt->wday < 1 || dt->wday > 7
+        || dt->month < 1 || dt->month > 12 || dt->year > 99)
+    {
+        return false;
+    }
+    monthLength = (uint8_t)(daysBeforeMonth[dt->month] - daysBeforeMonth[dt->month - 1]);
+    if (dt->month == 2 && (dt->year & 0x03) == 0)
+    {
+        monthLength++;
+    }
+    return dt->mday >= 1 && dt->mday <= monthLength;
+}
+
+void datetime_ToTm(const DateTime_t *dt, struct tm *tm_t)
+{
+    memset(tm_t, 0, sizeof (struct tm));
+    tm_t->tm_sec = dt->sec;
+    tm_t->tm_min = dt->min;
+    tm_t->tm_hour = dt->hour;
+    tm_t->tm_wday = dt->wday - 1;                                           // time.h gives Sunday as zero
+    tm_t->tm_mday = dt->mday;
+    tm_t->tm_mon = dt->month - 1;                                           // time.h gives January as zero
+    tm_t->tm_year = dt->year + 100;
+    tm_t->tm_yday = daysBeforeMonth[dt->month - 1] + dt->mday - 1 + ((dt->year & 0x03) == 0 && dt->month > 2);
+}
@@ -0,0 +1,129 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   
+ * Author: 
+ * Comments:
+ * Revision history: 
+ */
+
+
+/* 
+ * File:   datetime.h
+ * Author: 
+ * Comments: Packed calendar time in the layout of the RTCC time registers
+ * Revision history: 
+ */
+
+#ifndef DATETIME_H
+#define	DATETIME_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// include files
+#include <time.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define DATETIME_EPOCH_MIN          (946684800UL)                             //  2000-01-01 00:00:00 UTC
+#define DATETIME_EPOCH_MAX          (4102444799UL)                            //  2099-12-31 23:59:59 UTC, last year the clock can hold
+#define DATETIME_EPOCH_VALID(v)     ((v) >= DATETIME_EPOCH_MIN && (v) <= DATETIME_EPOCH_MAX)
+
+// One byte per field in the order of RTCC registers 0x00..0x06, 7 bytes
+typedef struct {
+    uint8_t sec;                                                             // 0..59
+    uint8_t min;                                                             // 0..59
+    uint8_t hour;                                                            // 0..23
+    uint8_t wday;                                                            // 1..7, Sunday is 1
+    uint8_t mday;                                                            // 1..31
+    uint8_t month;                                                           // 1..12
+    uint8_t year;                                                            // 0..99 for 2000..2099
+} DateTime_t;
+
+/**
+   @Param
+    year 0..99, month 1..12, day 1..31
+   @Returns
+    days since 1970-01-01
+   @Description
+    Day number of a date in 2000..2099
+   @Example
+    none
+ */
+uint16_t datetime_DaysFromCivil(uint8_t year, uint8_t month, uint8_t day);
+
+/**
+   @Param
+    epoch from 2000-01-01 onwards, destination date and time
+   @Returns
+    none
+   @Description
+    Splits an epoch into calendar fields (valid for 2000..2099, earlier
+    values give 2000-01-01 with the time of day kept)
+   @Example
+    none
+ */
+void datetime_FromEpoch(uint32_t epoch, DateTime_t *dt);
+
+/**
+   @Param
+    date and time
+   @Returns
+    seconds since 1970-01-01
+   @Description
+    Inverse of datetime_FromEpoch(), the weekday is not used
+   @Example
+    none
+ */
+uint32_t datetime_ToEpoch(const DateTime_t *dt);
+
+/**
+   @Param
+    date and time
+   @Returns
+    true when every field is in range and the day exists in that month
+   @Description
+    Checks a value read from the clock or received from the user
+   @Example
+    none
+ */
+bool datetime_IsValid(const DateTime_t *dt);
+
+/**
+   @Param
+    date and time, destination time structure
+   @Returns
+    none
+   @Description
+    Expands the packed fields for code that renders a struct tm
+   @Example
+    none
+ */
+void datetime_ToTm(const DateTime_t *dt, struct tm *tm_t);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,174 @@
+/*
+ * File:   latency.c
+ *
+ * Alarm path latency. The RB2 interrupt hands over the Timer1 value CCP1
+ * captured at the edge and the time it ran, the main loop takes the edge
+ * and marks when the alarm flag was cleared on the chip, so every stage
+ * is measured from the edge itself. The edge timing is always kept since
+ * each alarm record carries it; the histograms need LATENCY_ENABLE. Samples go into power of two histograms so the
+ * percentiles cost 32 bytes per stage; a percentile is reported as the
+ * upper end of its bucket. Timer1 runs from LFINTOSC, about 32 us a count.
+ */
+
+/*
+ ***********************************************************
+ *                                                         *
+ *                  Include Header Files                   *
+ *                                                         *
+ ***********************************************************
+*/
+#include <xc.h>
+#include <string.h>
+#include "latency.h"
+#include "console.h"
+#include "mcc_generated_files/system/system.h"
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              User Defined Variables                     *
+ *                                                         *
+ ***********************************************************
+*/
+static volatile uint16_t latEdge;                                            // Timer1 captured at the last edge
+static volatile uint16_t latEntry;                                           // Timer1 when the interrupt routine ran
+static uint16_t latTaken;                                                    // Edge of the last latency_Take()
+static volatile bool latPending;                                             // Edge not handled yet
+static volatile uint16_t latMissed;
+static uint16_t latHistogram[LATENCY_STAGES][LATENCY_BUCKETS];
+static uint16_t latSamples[LATENCY_STAGES];
+static uint16_t latMax[LATENCY_STAGES];
+
+static const char *const stageNames[LATENCY_STAGES] = {" Entry", " Handled", " Cleared"};
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              Static Function Declarations               *
+ *                                                         *
+ ***********************************************************
+*/
+static uint8_t latency_Bucket(uint16_t counts);
+static uint16_t latency_Percentile(uint8_t stage, uint8_t percent);
+static void latency_PutMicros(uint16_t counts);
+static void latency_Add(uint8_t stage, uint16_t counts);
+
+/*
+ ***********************************************************
+ *                                                         *
+ *          User Defined Function Definitions              *
+ *                                                         *
+ ***********************************************************
+*/
+
+// Index of the highest set bit, zero counts share bucket 0
+static uint8_t latency_Bucket(uint16_t counts)
+{
+    uint8_t bucket = 0;
+
+    while (counts >>= 1)
+    {
+        bucket++;
+    }
+    return bucket;
+}
+
+// Upper end of the bucket holding the given percentile
+static uint16_t latency_Percentile(uint8_t stage, uint8_t percent)
+{
+    uint32_t needed = ((uint32_t)latSamples[stage] * percent + 99) / 100;
+    uint32_t seen = 0;
+    uint8_t bucket;
+
+    for (bucket = 0; bucket < LATENCY_BUCKETS - 1; bucket++)
+    {
+        seen += latHistogram[stage][bucket];
+        if (seen >= needed)
+        {
+            break;
+        }
+    }
+    return (uint16_t)((2UL << bucket) - 1);
+}
+
+static void latency_PutMicros(uint16_t counts)
+{
+    console_PutChar('\t');
+    console_PutUnsigned((uint32_t)counts * 1000000UL / TMR1_NOMINAL_FREQUENCY, 0);
+}
+
+static void latency_Add(uint8_t stage, uint16_t counts)
+{
+    if (latSamples[stage] != UINT16_MAX)
+    {
+        latSamples[stage]++;
+        latHistogram[stage][latency_Bucket(counts)]++;
+    }
+    latMax[stage] = (counts > latMax[stage]) ? counts : latMax[stage];
+}
+
+void latency_Edge(uint16_t edge)
+{
+    latEntry = TMR1_Read();
+    if (latPending)
+    {
+        latMissed++;
+    }
+    latEdge = edge;
+    latPending = true;
+}
+
+bool latency_Take(LatencyEdge_t *sample)
+{
+    bool pending;
+    uint8_t iocEnabled = PIE0bits.IOCIE;
+
+    PIE0bits.IOCIE = 0;
+    sample->handled = TMR1_Read();
+    pending = latPending;
+    sample->edge = pending ? latEdge : sample->handled;
+    sample->entry = pending ? latEntry : sample->handled;
+    latPending = false;
+    PIE0bits.IOCIE = iocEnabled;
+
+    latTaken = sample->edge;
+#if LATENCY_ENABLE
+    if (pending)
+    {
+        latency_Add(LATENCY_ENTRY, sample->entry - sample->edge);
+        latency_Add(LATENCY_HANDLED, sample->handled - sample->edge);
+    }
+#endif
+    return pending;
+}
+
+void latency_Mark(uint8_t stage)
+{
+    latency_Add(stage, TMR1_Read() - latTaken);
+}
+
+void latency_Report(void)
+{
+    uint8_t stage;
+
+    console_PutString("\n\t\r Stage\t samples\t p50 us\t p99 us\t max us \n");
+    for (stage = 0; stage < LATENCY_STAGES; stage++)
+    {
+        console_PutString("\t\r");
+        console_PutString(stageNames[stage]);
+        console_PutChar('\t');
+        console_PutUnsigned(latSamples[stage], 0);
+        latency_PutMicros(latency_Percentile(stage, 50));
+        latency_PutMicros(latency_Percentile(stage, 99));
+        latency_PutMicros(latMax[stage]);
+        console_PutString("\n");
+    }
+    console_PutString("\t\r Missed edges : ");
+    console_PutUnsigned(latMissed, 0);
+    console_PutString("\n\n");
+
+    memset(latHistogram, 0, sizeof (latHistogram));
+    memset(latSamples, 0, sizeof (latSamples));
+    memset(latMax, 0, sizeof (latMax));
+    latMissed = 0;
+}
@@ -0,0 +1,131 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   
+ * Author: 
+ * Comments:
+ * Revision history: 
+ */
+
+
+/* 
+ * File:   latency.h
+ * Author: 
+ * Comments: Alarm path latency histograms measured with Timer1
+ * Revision history: 
+ */
+
+#ifndef LATENCY_H
+#define	LATENCY_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// include files
+#include <stdint.h>
+#include <stdbool.h>
+
+// Build with LATENCY_ENABLE=1 in the project macros to measure the alarm path
+#ifndef LATENCY_ENABLE
+#define LATENCY_ENABLE              (0)
+#endif
+
+#define LATENCY_ENTRY               (0)                                       //  RB2 edge to the interrupt routine
+#define LATENCY_HANDLED             (1)                                       //  RB2 edge to the main loop follow-up
+#define LATENCY_CLEARED             (2)                                       //  RB2 edge to ALMxIF cleared on the chip
+#define LATENCY_STAGES              (3)
+#define LATENCY_BUCKETS             (16)                                      //  Power of two buckets of Timer1 counts
+
+#if LATENCY_ENABLE
+#define LATENCY_MARK(stage)         latency_Mark(stage)
+#else
+#define LATENCY_MARK(stage)
+#endif
+
+// Timer1 values of one MFP edge, TMR1_NOMINAL_FREQUENCY counts per second
+typedef struct {
+    uint16_t edge;                                                           // Captured by CCP1 at the edge
+    uint16_t entry;                                                          // Interrupt routine ran
+    uint16_t handled;                                                        // Main loop took the edge
+} LatencyEdge_t;
+
+/**
+   @Param
+    Timer1 value CCP1 captured at the edge
+   @Returns
+    none
+   @Description
+    Called from the RB2 interrupt, keeps the captured edge and the time the
+    routine ran. An edge that arrives before the previous one was taken
+    counts as missed. Built in whatever LATENCY_ENABLE is.
+   @Example
+    latency_Edge(edge);
+ */
+void latency_Edge(uint16_t edge);
+
+/**
+   @Param
+    destination for the edge timing
+   @Returns
+    false when no edge arrived since the last call, the timing then reads
+    the current Timer1 value throughout
+   @Description
+    Called from the main loop when it follows up an edge. Completes the
+    edge and, with LATENCY_ENABLE, adds its LATENCY_ENTRY and
+    LATENCY_HANDLED samples.
+   @Example
+    none
+ */
+bool latency_Take(LatencyEdge_t *sample);
+
+/**
+   @Param
+    LATENCY_CLEARED
+   @Returns
+    none
+   @Description
+    Adds the time since the edge last taken to the histogram of the stage
+   @Example
+    LATENCY_MARK(LATENCY_CLEARED);
+ */
+void latency_Mark(uint8_t stage);
+
+/**
+   @Param
+    none
+   @Returns
+    none
+   @Description
+    Prints samples, p50, p99 and max in microseconds for each stage and
+    the missed edge count, then starts a new measurement
+   @Example
+    none
+ */
+void latency_Report(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* LATENCY_H */
+
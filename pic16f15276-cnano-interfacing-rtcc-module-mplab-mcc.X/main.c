@@ -11,7 +11,7 @@
 */
 
 /*
- [2023] Microchip Technology Inc. and its subsidiaries.
+© [2023] Microchip Technology Inc. and its subsidiaries.
 
     Subject to your compliance with these terms, you may use Microchip 
     software and any derivatives exclusively with Microchip products. 
@@ -32,6 +32,10 @@
 */
 #include "mcc_generated_files/system/system.h"
 #include "application.h"
+#include "boot.h"
+#include "pinevent.h"
+#include "timestamp.h"
+#include "supervisor.h"
 /*
     Main application
 */
@@ -39,6 +43,8 @@
 int main(void)
 {
     SYSTEM_Initialize();
+    supervisor_Initialize(SUPERVISOR_CHECK_LOOP | SUPERVISOR_CHECK_CONSOLE);  // Every wait below is bounded by a deadline
+    boot_Initialize();                                                       // Alarm interrupt armed before any bus traffic
 
     // If using interrupts in PIC18 High/Low Priority Mode you need to enable the Global High and Low Interrupts 
     // If using interrupts in PIC Mid-Range Compatibility Mode you need to enable the Global and Peripheral Interrupts 
@@ -56,16 +62,14 @@ int main(void)
     // Disable the Peripheral Interrupts 
     //INTERRUPT_PeripheralInterruptDisable(); 
 
-    printf(" RTCC Example \n Please enter the input of your choice: \n");
-    printf(" A - Setting the time \n B - Setting the alarm \n C - Reading the current time \n\n");    
-    
-    rtc6_Initialize();
-    
-    RB2_SetInterruptHandler(Rtcc_External_Interrupt);
-    
     while(1)
     {
+        boot_Step();                                                         // RTCC, SRAM records, then the banner
         rtc_Application();
+        pinevent_Service();                                                  // Ages the MFP pulse filter
+        timestamp_Service();                                                 // Holds the time when the 1 Hz edges stop
         // Add your application code
+        supervisor_Checkpoint(SUPERVISOR_CHECK_LOOP);
+        supervisor_Service();
     }    
 }
\ No newline at end of file
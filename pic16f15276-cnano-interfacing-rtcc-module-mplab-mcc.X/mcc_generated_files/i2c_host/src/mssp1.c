@@ -33,6 +33,7 @@
 
 #include <xc.h>
 #include "../mssp1.h"
+#include "../../../trace.h"
 
 /* I2C1 event system interfaces */
 static void I2C1_ReadStart(void);
@@ -236,12 +237,14 @@ void I2C1_Tasks(void)
  */
 static void I2C1_ReadStart(void)
 {
+    TRACE(TRACE_I2C_START, i2c1Status.address);
     I2C1_StartSend();
     i2c1Status.state = I2C_STATE_SEND_RD_ADDR;
 }
 
 static void I2C1_WriteStart(void)
 {
+    TRACE(TRACE_I2C_START, i2c1Status.address);
     I2C1_StartSend();
     i2c1Status.state = I2C_STATE_SEND_WR_ADDR;
 }
@@ -272,12 +275,14 @@ static void I2C1_EventHandler(void)
         i2c1Status.errorState = I2C_ERROR_DATA_NACK;
     }
     i2c1Status.state = i2c1_eventTable[i2c1Status.state]();
+    TRACE(TRACE_I2C_STATE, i2c1Status.state);
 }
 
 static void I2C1_ErrorEventHandler(void)
 {
     i2c1Status.state = I2C_STATE_ERROR;
     i2c1Status.errorState = I2C_ERROR_BUS_COLLISION;
+    TRACE(TRACE_I2C_ERROR, i2c1Status.errorState);
     I2C1_ErrorInterruptClear();
     i2c1Status.state = i2c1_eventTable[i2c1Status.state]();
     I2C1_Callback();
@@ -34,6 +34,48 @@
 #ifndef INTERRUPT_H
 #define INTERRUPT_H
 
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @ingroup interrupt
+ * @brief Set INTERRUPT_STATS_ENABLE to 0 in the project macros to drop the entry counts and service times.
+ */
+#ifndef INTERRUPT_STATS_ENABLE
+#define INTERRUPT_STATS_ENABLE (1)
+#endif
+
+/**
+ * @ingroup interrupt
+ * @brief Timer0 counts per microsecond; with the statistics enabled Timer0 runs from Fosc/4 to time the handlers.
+ */
+#define INTERRUPT_STATS_COUNTS_PER_US (_XTAL_FREQ / 4000000UL)
+
+/**
+ * @ingroup interrupt
+ * @brief Interrupt sources in the order they are serviced, highest priority first.
+ */
+typedef enum
+{
+    INTERRUPT_SOURCE_IOC,
+    INTERRUPT_SOURCE_INT,
+    INTERRUPT_SOURCE_BCL1,
+    INTERRUPT_SOURCE_SSP1,
+    INTERRUPT_SOURCE_RC1,
+    INTERRUPT_SOURCE_TX1,
+    INTERRUPT_SOURCE_TMR1,
+    INTERRUPT_SOURCE_COUNT
+} INTERRUPT_SOURCE;
+
+/**
+ * @ingroup interrupt
+ * @brief Entry count and longest service time of one source.
+ */
+typedef struct
+{
+    uint16_t count;     /**< Handler calls, wraps at 65536 */
+    uint16_t worst;     /**< Longest handler run in Timer0 counts, see INTERRUPT_STATS_COUNTS_PER_US */
+} INTERRUPT_STATS;
 
 /**
  * @ingroup interrupt
@@ -84,6 +126,48 @@
  */
 void INTERRUPT_Initialize (void);
 
+/**
+ * @ingroup interrupt
+ * @brief Registers the handler the dispatcher calls for a source. A pending source without a handler is disabled.
+ * @param source - Interrupt source.
+ * @param (*InterruptHandler)(void) - InterruptHandler function pointer, NULL to remove it.
+ * @return None.
+ */
+void INTERRUPT_SetHandler(INTERRUPT_SOURCE source, void (* InterruptHandler)(void));
+
+/**
+ * @ingroup interrupt
+ * @brief Sets the interrupt enable bit of a source.
+ * @param source - Interrupt source.
+ * @return None.
+ */
+void INTERRUPT_SourceEnable(INTERRUPT_SOURCE source);
+
+/**
+ * @ingroup interrupt
+ * @brief Clears the interrupt enable bit of a source.
+ * @param source - Interrupt source.
+ * @return None.
+ */
+void INTERRUPT_SourceDisable(INTERRUPT_SOURCE source);
+
+/**
+ * @ingroup interrupt
+ * @brief Copies the entry count and worst service time of a source, all zero when INTERRUPT_STATS_ENABLE is 0.
+ * @param source - Interrupt source.
+ * @param stats - Destination.
+ * @return None.
+ */
+void INTERRUPT_StatsGet(INTERRUPT_SOURCE source, INTERRUPT_STATS *stats);
+
+/**
+ * @ingroup interrupt
+ * @brief Restarts the entry counts and worst service times.
+ * @param None.
+ * @return None.
+ */
+void INTERRUPT_StatsClear(void);
+
 
 /**
  * @ingroup interrupt
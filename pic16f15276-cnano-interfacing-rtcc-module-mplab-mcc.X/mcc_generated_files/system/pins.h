@@ -46,6 +46,13 @@
 #define ANALOG      1
 #define DIGITAL     0
 
+// Ports with interrupt-on-change, index of the IOC handler table
+#define PIN_MANAGER_PORT_A  0
+#define PIN_MANAGER_PORT_B  1
+#define PIN_MANAGER_PORT_C  2
+#define PIN_MANAGER_PORT_E  3
+#define PIN_MANAGER_IOC_PORTS   4
+
 #define PULL_UP_ENABLED      1
 #define PULL_UP_DISABLED     0
 
@@ -180,6 +187,17 @@ void PIN_MANAGER_Initialize (void);
  */
 void PIN_MANAGER_IOC(void);
 
+/**
+ * @ingroup  pinsdriver
+ * @brief Interrupt on Change handler setter for any pin. The handler runs for every
+ *        IOC flag of the pin while one of its edges is enabled in IOCxP/IOCxN.
+ * @param port PIN_MANAGER_PORT_x.
+ * @param bit Pin number 0..7.
+ * @param InterruptHandler function pointer, NULL to ignore the pin.
+ * @return none
+ */
+void PIN_MANAGER_SetIOCHandler(uint8_t port, uint8_t bit, void (* InterruptHandler)(void));
+
 /**
  * @ingroup  pinsdriver
  * @brief Interrupt on Change Handler for the IO_RB2 pin functionality
@@ -198,17 +216,6 @@ void IO_RB2_ISR(void);
  */
 void IO_RB2_SetInterruptHandler(void (* InterruptHandler)(void));
 
-/**
- * @ingroup  pinsdriver
- * @brief Dynamic Interrupt Handler for IO_RB2 pin.
- *        This is a dynamic interrupt handler to be used together with the IO_RB2_SetInterruptHandler() method.
- *        This handler is called every time the IO_RB2 ISR is executed and allows any function to be registered at runtime.
- * @pre Pins intializer called
- * @param none
- * @return none
- */
-extern void (*IO_RB2_InterruptHandler)(void);
-
 /**
  * @ingroup  pinsdriver
  * @brief Default Interrupt Handler for IO_RB2 pin. 
@@ -42,7 +42,7 @@
 //CONFIG2
 #pragma config MCLRE = EXTMCLR     // Master Clear Enable bit->If LVP = 0, MCLR pin is MCLR; If LVP = 1, RE3 pin function is MCLR
 #pragma config PWRTS = PWRT_OFF     // Power-up Timer Selection bits->PWRT is disabled
-#pragma config WDTE = OFF     // WDT Operating Mode bits->WDT disabled; SEN is ignored
+#pragma config WDTE = SWDTEN     // WDT Operating Mode bits->WDT enabled/disabled by SEN bit
 #pragma config BOREN = ON     // Brown-out Reset Enable bits->Brown-out Reset Enabled, SBOREN bit is ignored
 #pragma config BORV = LO     // Brown-out Reset Voltage Selection bit->Brown-out Reset Voltage (VBOR) set to 1.9V
 #pragma config PPS1WAY = ON     // PPSLOCKED One-Way Set Enable bit->The PPSLOCKED bit can be set once after an unlocking sequence is executed; once PPSLOCKED is set, all future changes to PPS registers are prevented
@@ -34,9 +34,56 @@
 #include "../../system/interrupt.h"
 #include "../../system/system.h"
 #include "../pins.h"
+#include <string.h>
 
 void (*INT_InterruptHandler)(void);
 
+/**
+ * @ingroup interrupt
+ * @brief Enable and flag bits of one source; PIEx and PIRx share the bit positions.
+ */
+typedef struct
+{
+    volatile uint8_t *enable;
+    volatile uint8_t *flag;
+    uint8_t mask;
+    bool peripheral;    /**< Also gated by PEIE */
+} INTERRUPT_SOURCE_ENTRY;
+
+static void INTERRUPT_Tx1Handler(void);
+
+static const INTERRUPT_SOURCE_ENTRY interruptSources[INTERRUPT_SOURCE_COUNT] =
+{
+    [INTERRUPT_SOURCE_IOC]  = {&PIE0, &PIR0, _PIR0_IOCIF_MASK, false},
+    [INTERRUPT_SOURCE_INT]  = {&PIE0, &PIR0, _PIR0_INTF_MASK, false},
+    [INTERRUPT_SOURCE_BCL1] = {&PIE1, &PIR1, _PIR1_BCL1IF_MASK, true},
+    [INTERRUPT_SOURCE_SSP1] = {&PIE1, &PIR1, _PIR1_SSP1IF_MASK, true},
+    [INTERRUPT_SOURCE_RC1]  = {&PIE1, &PIR1, _PIR1_RC1IF_MASK, true},
+    [INTERRUPT_SOURCE_TX1]  = {&PIE1, &PIR1, _PIR1_TX1IF_MASK, true},
+    [INTERRUPT_SOURCE_TMR1] = {&PIE1, &PIR1, _PIR1_TMR1IF_MASK, true},
+};
+
+static void (*interruptHandlers[INTERRUPT_SOURCE_COUNT])(void) =
+{
+    [INTERRUPT_SOURCE_IOC]  = PIN_MANAGER_IOC,
+    [INTERRUPT_SOURCE_INT]  = INT_ISR,
+    [INTERRUPT_SOURCE_TX1]  = INTERRUPT_Tx1Handler,
+};
+
+#if INTERRUPT_STATS_ENABLE
+static INTERRUPT_STATS interruptStats[INTERRUPT_SOURCE_COUNT];
+
+/**
+ * @ingroup interrupt
+ * @brief Reads the 16-bit Timer0, the read of TMR0L latches TMR0H.
+ */
+static uint16_t INTERRUPT_StatsTimer(void)
+{
+    uint8_t low = TMR0L;
+    return (uint16_t)(((uint16_t)TMR0H << 8) | low);
+}
+#endif
+
 void  INTERRUPT_Initialize (void)
 {
     // Clear the interrupt flag
@@ -47,28 +94,105 @@ void  INTERRUPT_Initialize (void)
     INT_SetInterruptHandler(INT_DefaultInterruptHandler);
     // EXT_INT_InterruptEnable();
 
+#if INTERRUPT_STATS_ENABLE
+    // Timer0 free runs for the handler timing: 16-bit, Fosc/4, no prescaler, wraps after 16 ms
+    T0CON1 = 0x40;      // T0CS = Fosc/4, synchronous, prescaler 1:1
+    T0CON0 = 0x90;      // T0EN = 1, T016BIT = 1, postscaler 1:1
+#endif
+}
+
+static void INTERRUPT_Tx1Handler(void)
+{
+    EUSART1_TxInterruptHandler();
 }
 
 /**
  * @ingroup interrupt
  * @brief Services the Interrupt Service Routines (ISR) of enabled interrupts and is called every time an interrupt is triggered.
+ * Every pending source is serviced in one entry, in table order.
  * @pre Interrupt Manager is initialized.
  * @param None.
  * @return None.
  */
 void __interrupt() INTERRUPT_InterruptManager (void)
 {
-    // interrupt handler
-    if(PIE0bits.IOCIE == 1 && PIR0bits.IOCIF == 1)
-    {
-        PIN_MANAGER_IOC();
-    }
-    else
+    const INTERRUPT_SOURCE_ENTRY *entry = interruptSources;
+    uint8_t source;
+#if INTERRUPT_STATS_ENABLE
+    uint16_t start;
+    uint16_t elapsed;
+#endif
+
+    for(source = 0; source < INTERRUPT_SOURCE_COUNT; source++, entry++)
     {
-        //Unhandled Interrupt
+        if((*entry->enable & *entry->flag & entry->mask) == 0 || (entry->peripheral && INTCONbits.PEIE == 0))
+        {
+            continue;
+        }
+        if(interruptHandlers[source] == NULL)
+        {
+            *entry->enable &= (uint8_t)~entry->mask;                        // Unhandled Interrupt, stop it from firing again
+            continue;
+        }
+#if INTERRUPT_STATS_ENABLE
+        start = INTERRUPT_StatsTimer();
+        interruptHandlers[source]();
+        elapsed = INTERRUPT_StatsTimer() - start;
+        interruptStats[source].count++;
+        if(elapsed > interruptStats[source].worst)
+        {
+            interruptStats[source].worst = elapsed;
+        }
+#else
+        interruptHandlers[source]();
+#endif
     }
 }
 
+void INTERRUPT_SetHandler(INTERRUPT_SOURCE source, void (* InterruptHandler)(void))
+{
+    uint8_t state = INTERRUPT_GlobalInterruptStatus();
+
+    INTERRUPT_GlobalInterruptDisable();                                      // The pointer is two bytes wide
+    interruptHandlers[source] = InterruptHandler;
+    INTCONbits.GIE = state;
+}
+
+void INTERRUPT_SourceEnable(INTERRUPT_SOURCE source)
+{
+    *interruptSources[source].enable |= interruptSources[source].mask;
+}
+
+void INTERRUPT_SourceDisable(INTERRUPT_SOURCE source)
+{
+    *interruptSources[source].enable &= (uint8_t)~interruptSources[source].mask;
+}
+
+void INTERRUPT_StatsGet(INTERRUPT_SOURCE source, INTERRUPT_STATS *stats)
+{
+#if INTERRUPT_STATS_ENABLE
+    uint8_t state = INTERRUPT_GlobalInterruptStatus();
+
+    INTERRUPT_GlobalInterruptDisable();
+    *stats = interruptStats[source];
+    INTCONbits.GIE = state;
+#else
+    stats->count = 0;
+    stats->worst = 0;
+#endif
+}
+
+void INTERRUPT_StatsClear(void)
+{
+#if INTERRUPT_STATS_ENABLE
+    uint8_t state = INTERRUPT_GlobalInterruptStatus();
+
+    INTERRUPT_GlobalInterruptDisable();
+    memset(interruptStats, 0, sizeof (interruptStats));
+    INTCONbits.GIE = state;
+#endif
+}
+
 void INT_ISR(void)
 {
     EXT_INT_InterruptFlagClear();
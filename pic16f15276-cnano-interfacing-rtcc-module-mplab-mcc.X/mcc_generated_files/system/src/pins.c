@@ -34,7 +34,28 @@
 
 #include "../pins.h"
 
-void (*IO_RB2_InterruptHandler)(void);
+/**
+  IOC flag and edge enable registers of one port
+*/
+typedef struct
+{
+    volatile uint8_t *flag;
+    volatile uint8_t *positive;
+    volatile uint8_t *negative;
+} PIN_MANAGER_IOC_PORT;
+
+static const PIN_MANAGER_IOC_PORT iocPorts[PIN_MANAGER_IOC_PORTS] =
+{
+    [PIN_MANAGER_PORT_A] = {&IOCAF, &IOCAP, &IOCAN},
+    [PIN_MANAGER_PORT_B] = {&IOCBF, &IOCBP, &IOCBN},
+    [PIN_MANAGER_PORT_C] = {&IOCCF, &IOCCP, &IOCCN},
+    [PIN_MANAGER_PORT_E] = {&IOCEF, &IOCEP, &IOCEN},
+};
+
+// Index of the lowest set bit of a nibble, entry 0 is never used
+static const uint8_t iocFirstSet[16] = {0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0};
+
+static void (*iocHandlers[PIN_MANAGER_IOC_PORTS][8])(void);
 
 void PIN_MANAGER_Initialize(void)
 {
@@ -136,13 +157,50 @@ void PIN_MANAGER_Initialize(void)
     PIE0bits.IOCIE = 1; 
 }
   
+/**
+  One masked read per port, then one handler call per pending pin, lowest pin first
+*/
 void PIN_MANAGER_IOC(void)
 {
-    // interrupt on change for pin IO_RB2}
-    if(IOCBFbits.IOCBF2 == 1)
+    const PIN_MANAGER_IOC_PORT *port = iocPorts;
+    uint8_t index;
+    uint8_t pending;
+    uint8_t bit;
+
+    for(index = 0; index < PIN_MANAGER_IOC_PORTS; index++, port++)
+    {
+        pending = *port->flag & (*port->positive | *port->negative);
+        if(pending == 0)
+        {
+            continue;
+        }
+        // Datasheet clear: XOR with the flags just read is a single XORWF on
+        // the flag register, so an edge on any other pin, even one landing
+        // during this write, stays set for the next pass
+        *port->flag ^= pending;
+        do
+        {
+            bit = (pending & 0x0F) ? iocFirstSet[pending & 0x0F] : (uint8_t)(4 + iocFirstSet[pending >> 4]);
+            pending &= (uint8_t)(pending - 1);
+            if(iocHandlers[index][bit])
+            {
+                iocHandlers[index][bit]();
+            }
+        } while(pending);
+    }
+}
+
+void PIN_MANAGER_SetIOCHandler(uint8_t port, uint8_t bit, void (* InterruptHandler)(void))
+{
+    uint8_t iocEnabled = PIE0bits.IOCIE;
+
+    if(port >= PIN_MANAGER_IOC_PORTS || bit > 7)
     {
-        IO_RB2_ISR();  
+        return;
     }
+    PIE0bits.IOCIE = 0;                                                      // The pointer is two bytes wide
+    iocHandlers[port][bit] = InterruptHandler;
+    PIE0bits.IOCIE = iocEnabled;
 }
    
 /**
@@ -153,9 +211,9 @@ void IO_RB2_ISR(void) {
     // Add custom IOCBF2 code
 
     // Call the interrupt handler for the callback registered at runtime
-    if(IO_RB2_InterruptHandler)
+    if(iocHandlers[PIN_MANAGER_PORT_B][2])
     {
-        IO_RB2_InterruptHandler();
+        iocHandlers[PIN_MANAGER_PORT_B][2]();
     }
     IOCBFbits.IOCBF2 = 0;
 }
@@ -164,7 +222,7 @@ void IO_RB2_ISR(void) {
   Allows selecting an interrupt handler for IOCBF2 at application runtime
 */
 void IO_RB2_SetInterruptHandler(void (* InterruptHandler)(void)){
-    IO_RB2_InterruptHandler = InterruptHandler;
+    PIN_MANAGER_SetIOCHandler(PIN_MANAGER_PORT_B, 2, InterruptHandler);
 }
 
 /**
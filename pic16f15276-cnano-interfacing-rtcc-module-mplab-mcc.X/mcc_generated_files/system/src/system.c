@@ -40,6 +40,7 @@ void SYSTEM_Initialize(void)
     PIN_MANAGER_Initialize();
     EUSART1_Initialize();
     I2C1_Host_Initialize();
+    TMR1_Initialize();
     INTERRUPT_Initialize();
 }
 
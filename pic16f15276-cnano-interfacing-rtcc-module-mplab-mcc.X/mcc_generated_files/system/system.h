@@ -42,6 +42,7 @@
 #include "../system/pins.h"
 #include "../uart/eusart1.h"
 #include "../i2c_host/mssp1.h"
+#include "../timer/tmr1.h"
 #include "../system/interrupt.h"
 
 /**
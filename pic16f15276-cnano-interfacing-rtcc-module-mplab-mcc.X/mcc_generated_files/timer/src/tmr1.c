@@ -0,0 +1,93 @@
+/**
+ * TMR1 Generated Driver File
+ *
+ * @file tmr1.c
+ *
+ * @ingroup tmr1
+ *
+ * @brief This file contains the API implementation for the TMR1 driver.
+ *
+ * @version TMR1 Driver Version 4.0.0
+*/
+
+/*
+ [2023] Microchip Technology Inc. and its subsidiaries.
+
+    Subject to your compliance with these terms, you may use Microchip 
+    software and any derivatives exclusively with Microchip products. 
+    You are responsible for complying with 3rd party license terms  
+    applicable to your use of 3rd party software (including open source  
+    software) that may accompany Microchip software. SOFTWARE IS ?AS IS.? 
+    NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS 
+    SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,  
+    MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT 
+    WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY 
+    KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF 
+    MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE 
+    FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP?S 
+    TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL NOT 
+    EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR 
+    THIS SOFTWARE.
+*/
+
+#include <xc.h>
+#include "../tmr1.h"
+
+void TMR1_Initialize(void)
+{
+    //TMR1ON disabled; RD16 enabled; nT1SYNC synchronize; CKPS 1:1; 
+    T1CON = 0x2;
+    //GE disabled; T1GPOL low; T1GTM disabled; T1GSPM disabled; T1GGO done; T1GVAL undefined; 
+    T1GCON = 0x0;
+    //GSS T1G_pin; 
+    T1GATE = 0x0;
+    //CS LFINTOSC; 
+    T1CLK = 0x4;
+    //TMR1H 0; 
+    TMR1H = 0x0;
+    //TMR1L 0; 
+    TMR1L = 0x0;
+
+    // Clearing TMR1IF flag before enabling the interrupt.
+    PIR1bits.TMR1IF = 0;
+    // TMR1 is polled, the 16-bit range covers more than two seconds.
+    PIE1bits.TMR1IE = 0;
+
+    TMR1_Start();
+}
+
+void TMR1_Start(void)
+{
+    T1CONbits.TMR1ON = 1;
+}
+
+void TMR1_Stop(void)
+{
+    T1CONbits.TMR1ON = 0;
+}
+
+uint16_t TMR1_Read(void)
+{
+    uint16_t readVal;
+    uint8_t readValHigh;
+    uint8_t readValLow;
+
+    readValLow = TMR1L;
+    readValHigh = TMR1H;
+    readVal = ((uint16_t)readValHigh << 8) | readValLow;
+    return readVal;
+}
+
+void TMR1_Write(uint16_t timerVal)
+{
+    bool onState = T1CONbits.TMR1ON;
+
+    T1CONbits.TMR1ON = 0;
+    TMR1H = (uint8_t)(timerVal >> 8);
+    TMR1L = (uint8_t)timerVal;
+    T1CONbits.TMR1ON = onState;
+}
+/**
+ End of File
+*/
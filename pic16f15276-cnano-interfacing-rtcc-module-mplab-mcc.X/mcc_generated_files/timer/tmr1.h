@@ -0,0 +1,94 @@
+/**
+ * TMR1 Generated Driver API Header File
+ *
+ * @file tmr1.h
+ *
+ * @defgroup tmr1 TMR1
+ *
+ * @brief This file contains API prototypes and other data types for the TMR1 driver.
+ *
+ * @version TMR1 Driver Version 4.0.0
+*/
+
+/*
+ [2023] Microchip Technology Inc. and its subsidiaries.
+
+    Subject to your compliance with these terms, you may use Microchip 
+    software and any derivatives exclusively with Microchip products. 
+    You are responsible for complying with 3rd party license terms  
+    applicable to your use of 3rd party software (including open source  
+    software) that may accompany Microchip software. SOFTWARE IS ?AS IS.? 
+    NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS 
+    SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,  
+    MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT 
+    WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY 
+    KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF 
+    MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE 
+    FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP?S 
+    TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL NOT 
+    EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR 
+    THIS SOFTWARE.
+*/
+
+#ifndef TMR1_H
+#define TMR1_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @ingroup tmr1
+ * @brief Timer1 input clock in Hz. LFINTOSC is nominal only, callers that
+ *        need an exact rate calibrate against an external reference.
+ */
+#define TMR1_NOMINAL_FREQUENCY (31000UL)
+
+/**
+ * @ingroup tmr1
+ * @brief Initializes Timer1 as a free-running 16-bit counter clocked from LFINTOSC.
+ * @param None.
+ * @return None.
+ */
+void TMR1_Initialize(void);
+
+/**
+ * @ingroup tmr1
+ * @brief Starts Timer1.
+ * @pre TMR1_Initialize() is already called.
+ * @param None.
+ * @return None.
+ */
+void TMR1_Start(void);
+
+/**
+ * @ingroup tmr1
+ * @brief Stops Timer1.
+ * @pre TMR1_Initialize() is already called.
+ * @param None.
+ * @return None.
+ */
+void TMR1_Stop(void);
+
+/**
+ * @ingroup tmr1
+ * @brief Reads the 16-bit counter value. The high byte is latched by the low byte read (RD16).
+ * @pre TMR1_Initialize() is already called.
+ * @param None.
+ * @return 16-bit counter value.
+ */
+uint16_t TMR1_Read(void);
+
+/**
+ * @ingroup tmr1
+ * @brief Writes the 16-bit counter value.
+ * @pre TMR1_Initialize() is already called.
+ * @param timerVal - 16-bit counter value.
+ * @return None.
+ */
+void TMR1_Write(uint16_t timerVal);
+
+#endif //TMR1_H
+/**
+ End of File
+*/
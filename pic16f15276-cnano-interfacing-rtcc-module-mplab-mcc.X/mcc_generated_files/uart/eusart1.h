@@ -108,6 +108,12 @@ typedef union {
  */
 extern const uart_drv_interface_t EUSART1;
 
+/**
+ * @ingroup eusart1
+ * @brief Transmit interrupt handler called from the interrupt manager.
+ */
+extern void (*EUSART1_TxInterruptHandler)(void);
+
 /**
  * @ingroup eusart1
  * @brief This API initializes the EUSART1 driver.
@@ -274,14 +280,33 @@ uint8_t EUSART1_Read(void);
 
 /**
  * @ingroup eusart1
- * @brief This function writes a byte of data to the transmitter FIFO register.
- * @pre The transfer status should be checked to see if the transmitter is ready to accept a byte
- *      before calling this function. EUSART1_IsTxReady() should be checked in if() before calling this API.
+ * @brief This function writes a byte of data to the transmit buffer.
+ *        The byte is sent by EUSART1_TransmitISR(); the call blocks only while the buffer is full.
  * @param txData  - Data byte to write to the TX FIFO.
  * @return None.
  */
 void EUSART1_Write(uint8_t txData);
 
+/**
+ * @ingroup eusart1
+ * @brief This function copies a block of data into the transmit buffer.
+ *        The block is copied in as few critical sections as the free space allows,
+ *        blocking only while the buffer is full.
+ * @param txData - Pointer to the data to transmit.
+ * @param length - Number of bytes to transmit.
+ * @return None.
+ */
+void EUSART1_WriteBuffer(const uint8_t *txData, uint8_t length);
+
+/**
+ * @ingroup eusart1
+ * @brief This is the ISR function which moves the next buffered byte to TX1REG
+ *        and disables the transmit interrupt once the buffer is empty.
+ * @param None.
+ * @return None.
+ */
+void EUSART1_TransmitISR(void);
+
 /**
  * @ingroup eusart1
  * @brief This API registers the function to be called upon framing error.
@@ -35,10 +35,13 @@
   Section: Included Files
 */
 #include "../eusart1.h"
+#include "../../../trace.h"
 
 /**
   Section: Macro Declarations
 */
+#define EUSART1_TX_BUFFER_SIZE (64) //buffer size should be 2^n
+#define EUSART1_TX_BUFFER_MASK (EUSART1_TX_BUFFER_SIZE - 1)
 
 /**
   Section: Driver Interface
@@ -74,6 +77,11 @@ const uart_drv_interface_t EUSART1 = {
 /**
   Section: EUSART1 variables
 */
+static volatile uint8_t eusart1TxHead = 0;
+static volatile uint8_t eusart1TxTail = 0;
+static volatile uint8_t eusart1TxBuffer[EUSART1_TX_BUFFER_SIZE];
+volatile uint8_t eusart1TxBufferRemaining;
+
 volatile eusart1_status_t eusart1RxLastError;
 
 /**
@@ -81,6 +89,7 @@ volatile eusart1_status_t eusart1RxLastError;
 */
 
 void (*EUSART1_FramingErrorHandler)(void);
+void (*EUSART1_TxInterruptHandler)(void);
 void (*EUSART1_OverrunErrorHandler)(void);
 
 static void EUSART1_DefaultFramingErrorCallback(void);
@@ -110,6 +119,12 @@ void EUSART1_Initialize(void)
     EUSART1_OverrunErrorCallbackRegister(EUSART1_DefaultOverrunErrorCallback);
     eusart1RxLastError.status = 0;  
 
+    eusart1TxHead = 0;
+    eusart1TxTail = 0;
+    eusart1TxBufferRemaining = sizeof(eusart1TxBuffer);
+    EUSART1_TxInterruptHandler = EUSART1_TransmitISR;
+    PIE1bits.TX1IE = 0;
+
 }
 
 void EUSART1_Deinitialize(void)
@@ -197,12 +212,12 @@ bool EUSART1_IsRxReady(void)
 
 bool EUSART1_IsTxReady(void)
 {
-    return (bool)(PIR1bits.TX1IF && TX1STAbits.TXEN);
+    return (eusart1TxBufferRemaining ? true : false);
 }
 
 bool EUSART1_IsTxDone(void)
 {
-    return TX1STAbits.TRMT;
+    return (bool)((sizeof(eusart1TxBuffer) == eusart1TxBufferRemaining) && TX1STAbits.TRMT);
 }
 
 size_t EUSART1_ErrorGet(void)
@@ -212,6 +227,8 @@ size_t EUSART1_ErrorGet(void)
 
 uint8_t EUSART1_Read(void)
 {
+    uint8_t rxData;
+
     eusart1RxLastError.status = 0;
     if(RC1STAbits.OERR)
     {
@@ -229,12 +246,62 @@ uint8_t EUSART1_Read(void)
             EUSART1_FramingErrorHandler();
         }   
     }
-    return RC1REG;
+    rxData = RC1REG;
+    TRACE(TRACE_UART_RX, rxData);
+    return rxData;
 }
 
 void EUSART1_Write(uint8_t txData)
 {
-    TX1REG = txData;
+    TRACE(TRACE_UART_TX, txData);
+    while(0 == eusart1TxBufferRemaining)
+    {
+    }
+
+    PIE1bits.TX1IE = 0; //Critical value decrement
+    eusart1TxBuffer[eusart1TxHead] = txData;
+    eusart1TxHead = (eusart1TxHead + 1) & EUSART1_TX_BUFFER_MASK;
+    eusart1TxBufferRemaining--;
+    PIE1bits.TX1IE = 1;
+}
+
+void EUSART1_WriteBuffer(const uint8_t *txData, uint8_t length)
+{
+    uint8_t count;
+
+    TRACE(TRACE_UART_TX_BLOCK, length);
+    while(length)
+    {
+        while(0 == eusart1TxBufferRemaining)
+        {
+        }
+
+        PIE1bits.TX1IE = 0; //Copy as much of the chunk as fits in one critical section
+        count = (length < eusart1TxBufferRemaining) ? length : eusart1TxBufferRemaining;
+        length -= count;
+        eusart1TxBufferRemaining -= count;
+        while(count--)
+        {
+            eusart1TxBuffer[eusart1TxHead] = *txData++;
+            eusart1TxHead = (eusart1TxHead + 1) & EUSART1_TX_BUFFER_MASK;
+        }
+        PIE1bits.TX1IE = 1;
+    }
+}
+
+void EUSART1_TransmitISR(void)
+{
+    // use this default transmit interrupt handler code
+    if(sizeof(eusart1TxBuffer) > eusart1TxBufferRemaining)
+    {
+        TX1REG = eusart1TxBuffer[eusart1TxTail];
+        eusart1TxTail = (eusart1TxTail + 1) & EUSART1_TX_BUFFER_MASK;
+        eusart1TxBufferRemaining++;
+    }
+    else
+    {
+        PIE1bits.TX1IE = 0;
+    }
 }
 
 int getch(void)
@@ -0,0 +1,201 @@
+/*
+ * File:   pinevent.c
+ *
+ * The RTCC multifunction pin drives RB2. Every edge lands here first and
+ * is checked against the pin level and Timer1 before anything else runs,
+ * so noise costs a few instructions in the interrupt and never wakes the
+ * main loop or starts I2C traffic. Edge times come from the CCP1 capture
+ * of Timer1 rather than a read in the interrupt, so they carry no
+ * interrupt latency. The main loop retires the last pulse once minInterval
+ * has passed, before a Timer1 wrap can make an old pulse look recent.
+ */
+
+/*
+ ***********************************************************
+ *                                                         *
+ *                  Include Header Files                   *
+ *                                                         *
+ ***********************************************************
+*/
+#include <xc.h>
+#include "pinevent.h"
+#include "systime.h"
+
+#define COUNTS_PER_MS               (uint16_t)(TMR1_NOMINAL_FREQUENCY / 1000)
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              User Defined Variables                     *
+ *                                                         *
+ ***********************************************************
+*/
+static PinEventConfig_t peConfig;
+static PinEventHandler_t peHandlers[PINEVENT_TYPES];
+static bool peActiveHigh;
+static volatile bool peLeading;                                              // Leading edge seen, pulse still running
+static volatile bool peSeen;                                                 // peLast holds an accepted pulse
+static volatile uint16_t peLead;                                             // Timer1 at the leading edge
+static volatile uint16_t peLast;                                             // Timer1 at the last accepted pulse
+static volatile uint16_t peGlitches;
+static volatile uint8_t peAccepted;                                          // Pulses accepted, wraps
+static uint8_t peNoticed;                                                    // peAccepted as last seen by the main loop
+static uint32_t peNoticedAt;                                                 // systime_Millis() when it was seen
+static uint16_t peExpiryMs;                                                  // minInterval rounded up to milliseconds
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              Static Function Declarations               *
+ *                                                         *
+ ***********************************************************
+*/
+static void pinevent_Edge(void);
+static void pinevent_Accept(uint16_t edge);
+static uint16_t pinevent_Capture(void);
+
+/*
+ ***********************************************************
+ *                                                         *
+ *          User Defined Function Definitions              *
+ *                                                         *
+ ***********************************************************
+*/
+
+// Timer1 at the last RB2 edge, latched by CCP1
+static uint16_t pinevent_Capture(void)
+{
+    return (uint16_t)(((uint16_t)CCPR1H << 8) | CCPR1L);
+}
+
+// RB2 interrupt, the level tells a leading edge from a trailing one
+static void pinevent_Edge(void)
+{
+    uint16_t now = pinevent_Capture();
+    bool active = ((IO_RB2_GetValue() != 0) == peActiveHigh);
+
+    if (active)
+    {
+        if (peConfig.minInterval != 0 && peSeen && (uint16_t)(now - peLast) < peConfig.minInterval)
+        {
+            peLeading = false;
+            peGlitches++;                                                    // Too soon after the previous pulse
+            return;
+        }
+        peLead = now;
+        peLeading = (peConfig.minWidth != 0);
+        if (!peLeading)
+        {
+            pinevent_Accept(now);
+        }
+    }
+    else if (peConfig.edges != PINEVENT_EDGE_BOTH)
+    {
+        peGlitches++;                                                        // Pulse was over before the interrupt ran
+    }
+    else if (peLeading)
+    {
+        peLeading = false;
+        if ((uint16_t)(now - peLead) >= peConfig.minWidth)
+        {
+            pinevent_Accept(peLead);
+        }
+        else
+        {
+            peGlitches++;
+        }
+    }
+}
+
+static void pinevent_Accept(uint16_t edge)
+{
+    PinEventHandler_t handler = peHandlers[peConfig.type];
+
+    peLast = edge;
+    peSeen = true;
+    peAccepted++;
+    if (handler)
+    {
+        handler(edge);
+    }
+}
+
+void pinevent_Initialize(const PinEventConfig_t *config)
+{
+    uint8_t iocEnabled = PIE0bits.IOCIE;
+
+    PIE0bits.IOCIE = 0;
+    peConfig = *config;
+    if (peConfig.minWidth != 0)
+    {
+        peConfig.edges = PINEVENT_EDGE_BOTH;
+    }
+    peActiveHigh = ((config->edges & PINEVENT_EDGE_RISING) != 0);
+    peLeading = false;
+    peSeen = false;
+    peGlitches = 0;
+    peNoticed = peAccepted;
+    peExpiryMs = peConfig.minInterval / COUNTS_PER_MS + 1;
+    IOCBPbits.IOCBP2 = ((peConfig.edges & PINEVENT_EDGE_RISING) != 0);
+    IOCBNbits.IOCBN2 = ((peConfig.edges & PINEVENT_EDGE_FALLING) != 0);
+    IOCBFbits.IOCBF2 = 0;
+    CCP1CON = 0;                                                             // Mode changes are made with the module off
+    CCP1PPS = PINEVENT_CAPTURE_PPS;
+    CCPTMRS0bits.C1TSEL = PINEVENT_CAPTURE_TMR1;
+    if (peConfig.edges == PINEVENT_EDGE_BOTH)
+    {
+        CCP1CON = PINEVENT_CAPTURE_EN | PINEVENT_CAPTURE_BOTH;
+    }
+    else if (peConfig.edges == PINEVENT_EDGE_RISING)
+    {
+        CCP1CON = PINEVENT_CAPTURE_EN | PINEVENT_CAPTURE_RISING;
+    }
+    else
+    {
+        CCP1CON = PINEVENT_CAPTURE_EN | PINEVENT_CAPTURE_FALLING;
+    }
+    IO_RB2_SetInterruptHandler(pinevent_Edge);
+    PIE0bits.IOCIE = iocEnabled;
+}
+
+void pinevent_SetHandler(uint8_t type, PinEventHandler_t handler)
+{
+    uint8_t iocEnabled = PIE0bits.IOCIE;
+
+    if (type >= PINEVENT_TYPES)
+    {
+        return;
+    }
+    PIE0bits.IOCIE = 0;
+    peHandlers[type] = handler;
+    PIE0bits.IOCIE = iocEnabled;
+}
+
+void pinevent_Service(void)
+{
+    uint32_t now = systime_Millis();
+    uint8_t iocEnabled = PIE0bits.IOCIE;
+
+    PIE0bits.IOCIE = 0;
+    if (peAccepted != peNoticed)
+    {
+        peNoticed = peAccepted;
+        peNoticedAt = now;
+    }
+    else if (peSeen && now - peNoticedAt >= peExpiryMs)
+    {
+        peSeen = false;                                                      // Interval met, the Timer1 difference would wrap next
+    }
+    PIE0bits.IOCIE = iocEnabled;
+}
+
+uint16_t pinevent_Glitches(void)
+{
+    uint16_t glitches;
+    uint8_t iocEnabled = PIE0bits.IOCIE;
+
+    PIE0bits.IOCIE = 0;
+    glitches = peGlitches;
+    PIE0bits.IOCIE = iocEnabled;
+    return glitches;
+}
@@ -0,0 +1,140 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   
+ * Author: 
+ * Comments:
+ * Revision history: 
+ */
+
+
+/* 
+ * File:   pinevent.h
+ * Author: 
+ * Comments: Filtered events from the RTCC multifunction pin on RB2
+ * Revision history: 
+ */
+
+#ifndef PINEVENT_H
+#define	PINEVENT_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// include files
+#include <stdint.h>
+#include <stdbool.h>
+#include "mcc_generated_files/system/system.h"
+
+#define PINEVENT_EDGE_RISING        (0x01)
+#define PINEVENT_EDGE_FALLING       (0x02)
+#define PINEVENT_EDGE_BOTH          (PINEVENT_EDGE_RISING | PINEVENT_EDGE_FALLING)
+
+// What an accepted pulse on MFP means, follows SQWEN in the RTCC CONTROL register
+#define PINEVENT_SQUARE_WAVE        (0)                                       //  SQWEN=1, one pulse per second
+#define PINEVENT_ALARM              (1)                                       //  SQWEN=0, MFP asserts on an alarm match
+#define PINEVENT_TYPES              (2)
+
+// CCP1 latches Timer1 on the RB2 edges in hardware
+#define PINEVENT_CAPTURE_PPS        (0x0A)                                    //  CCP1PPS value for RB2
+#define PINEVENT_CAPTURE_TMR1       (0x01)                                    //  C1TSEL, capture from Timer1
+#define PINEVENT_CAPTURE_EN         (0x80)                                    //  CCP1CON EN
+#define PINEVENT_CAPTURE_BOTH       (0x03)                                    //  CCP1CON MODE, every edge
+#define PINEVENT_CAPTURE_FALLING    (0x04)                                    //  Every falling edge
+#define PINEVENT_CAPTURE_RISING     (0x05)                                    //  Every rising edge
+
+#define PINEVENT_SQW_MIN_INTERVAL   (uint16_t)(TMR1_NOMINAL_FREQUENCY * 3 / 4)  //  Square wave pulses closer than this are noise
+
+typedef struct {
+    uint8_t edges;                                                           // PINEVENT_EDGE_xxx, rising selects an active high pulse
+    uint8_t type;                                                            // PINEVENT_SQUARE_WAVE or PINEVENT_ALARM
+    uint16_t minInterval;                                                    // Timer1 counts between accepted pulses, 0 for no limit
+    uint16_t minWidth;                                                       // Timer1 counts a pulse must last, 0 to accept on the edge
+} PinEventConfig_t;
+
+typedef void (*PinEventHandler_t)(uint16_t edge);
+
+/**
+   @Param
+    pin configuration
+   @Returns
+    none
+   @Description
+    Selects the IOC edges of RB2 and the filter, and takes over the RB2
+    interrupt and CCP1. CCP1 captures Timer1 on the same edges, so edge
+    times do not depend on how long the interrupt took to run. An edge that finds the pin already back at its idle level,
+    comes within minInterval of the previous pulse or ends a pulse shorter
+    than minWidth is counted as a glitch and reaches no handler. A non zero
+    minWidth needs both edges, so they are enabled with it and the event is
+    raised on the trailing edge with the time of the leading one.
+   @Example
+    none
+ */
+void pinevent_Initialize(const PinEventConfig_t *config);
+
+/**
+   @Param
+    PINEVENT_SQUARE_WAVE or PINEVENT_ALARM, handler or NULL
+   @Returns
+    none
+   @Description
+    Sets the function called from the interrupt for accepted pulses of that
+    type. The handler gets the Timer1 value captured at the leading edge.
+   @Example
+    pinevent_SetHandler(PINEVENT_SQUARE_WAVE, Rtcc_External_Interrupt);
+ */
+void pinevent_SetHandler(uint8_t type, PinEventHandler_t handler);
+
+/**
+   @Param
+    none
+   @Returns
+    none
+   @Description
+    Called from the main loop. The minInterval test compares 16-bit Timer1
+    values, which wrap about every 2.1 s; once minInterval has passed since
+    the main loop saw the last pulse, the pulse is forgotten so the next
+    edge is accepted however long the pin stayed quiet. The loop has to
+    come round within a Timer1 period less minInterval.
+   @Example
+    none
+ */
+void pinevent_Service(void);
+
+/**
+   @Param
+    none
+   @Returns
+    edges rejected since initialization
+   @Description
+    Glitch count of the filter
+   @Example
+    none
+ */
+uint16_t pinevent_Glitches(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif
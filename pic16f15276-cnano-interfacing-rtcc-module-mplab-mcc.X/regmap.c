@@ -0,0 +1,397 @@
+/*
+ * File:   regmap.c
+ *
+ * Register access described by tables. A device is its I2C address plus a
+ * list of fields (register, bit position, width, BCD), so the driver asks
+ * for fields and this layer works out the register span, whether the span
+ * has to be read first and how few bursts can write it back.
+ *
+ * Writes to a device opened with regmap_Combine() are held in an image of
+ * its first registers and go out at regmap_Commit(), or earlier when a read
+ * touches a held register, with contiguous registers merged into one
+ * burst. Read-modify-write results of volatile registers are never held,
+ * since the value read ages while it waits.
+ */
+
+/*
+ ***********************************************************
+ *                                                         *
+ *                  Include Header Files                   *
+ *                                                         *
+ ***********************************************************
+*/
+#include <xc.h>
+#include <string.h>
+#include "regmap.h"
+#include "systime.h"
+#include "mcc_generated_files/system/system.h"
+#include "mcc_generated_files/i2c_host/mssp1.h"
+
+#define BUSY_TIMEOUT                (50)                                      //  ms before a stuck bus is given up, well over the longest burst
+#define IS_BCD(raw)                 (((raw) & 0x0F) <= 9 && ((raw) >> 4) <= 9)
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              User Defined Variables                     *
+ *                                                         *
+ ***********************************************************
+*/
+static const RegMapDevice_t *combineDevice;                                  // Device whose writes are held, NULL for none
+static uint32_t combinePending;                                              // Bit n set when register n is held
+static uint8_t combineImage[REGMAP_MASK_REGS];
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              Static Function Declarations               *
+ *                                                         *
+ ***********************************************************
+*/
+static bool regmap_Complete(bool retStatus);
+static bool regmap_Span(const RegMapDevice_t *dev, const uint8_t *ids, uint8_t count, uint8_t *first, uint8_t *length);
+static uint8_t regmap_Mask(const RegField_t *field);
+static bool regmap_InMask(uint32_t mask, uint8_t reg);
+static bool regmap_Send(const RegMapDevice_t *dev, uint8_t reg, const uint8_t *data, uint8_t length);
+static bool regmap_Put(const RegMapDevice_t *dev, uint8_t reg, const uint8_t *data, uint8_t length, bool hold);
+static bool regmap_Held(const RegMapDevice_t *dev, uint8_t reg, uint8_t length);
+static void regmap_Place(const RegField_t *field, uint8_t value, uint8_t *reg);
+
+/*
+ ***********************************************************
+ *                                                         *
+ *          User Defined Function Definitions              *
+ *                                                         *
+ ***********************************************************
+*/
+
+// Runs the queued transaction to completion, a bus that never finishes resets the host instead of hanging
+static bool regmap_Complete(bool retStatus)
+{
+    uint32_t deadline = systime_Millis() + BUSY_TIMEOUT;
+
+    if (retStatus)
+    {
+        while (I2C1_IsBusy())
+        {
+            I2C1_Tasks(); 
+            if (systime_Expired(deadline))
+            {
+                I2C1_Deinitialize();
+                I2C1_Initialize();
+                return false;
+            }
+        }
+        retStatus = (I2C1_ErrorGet() == I2C_ERROR_NONE);
+    }
+    return retStatus;
+}
+
+// Finds the registers covered by a list of fields, false for an unknown field or a span too long for one burst
+static bool regmap_Span(const RegMapDevice_t *dev, const uint8_t *ids, uint8_t count, uint8_t *first, uint8_t *length)
+{
+    uint8_t lo = 0xFF;
+    uint8_t hi = 0;
+    uint8_t reg;
+    uint8_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (ids[i] >= dev->fieldCount)
+        {
+            return false;
+        }
+        reg = dev->fields[ids[i]].reg;
+        lo = (reg < lo) ? reg : lo;
+        hi = (reg > hi) ? reg : hi;
+    }
+    if (count == 0 || hi - lo >= REGMAP_SPAN_MAX)
+    {
+        return false;
+    }
+    *first = lo;
+    *length = (uint8_t)(hi - lo + 1);
+    return true;
+}
+
+static uint8_t regmap_Mask(const RegField_t *field)
+{
+    return (uint8_t)(((1U << field->width) - 1U) << field->shift);
+}
+
+static bool regmap_InMask(uint32_t mask, uint8_t reg)
+{
+    return (reg < REGMAP_MASK_REGS) && (mask & REGMAP_BIT(reg));
+}
+
+// Writes consecutive registers in one transaction
+static bool regmap_Send(const RegMapDevice_t *dev, uint8_t reg, const uint8_t *data, uint8_t length)
+{
+    uint8_t txBuffer[REGMAP_SPAN_MAX + 1];
+
+    if (length > REGMAP_SPAN_MAX)
+    {
+        return false;
+    }
+    txBuffer[0] = reg;
+    memcpy(&txBuffer[1], data, length);
+    return regmap_Complete(I2C1_Write(dev->address, txBuffer, (size_t)length + 1));
+}
+
+// True when any of the registers is waiting in the combine image
+static bool regmap_Held(const RegMapDevice_t *dev, uint8_t reg, uint8_t length)
+{
+    uint8_t i;
+
+    if (dev != combineDevice || combinePending == 0)
+    {
+        return false;
+    }
+    for (i = 0; i < length; i++)
+    {
+        if (regmap_InMask(combinePending, (uint8_t)(reg + i)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Encodes a field into its register value, other bits are kept
+static void regmap_Place(const RegField_t *field, uint8_t value, uint8_t *reg)
+{
+    uint8_t encoded = field->bcd ? (uint8_t)(((value / 10) << 4) | (value % 10)) : value;
+
+    *reg = (uint8_t)((*reg & ~regmap_Mask(field)) | ((encoded << field->shift) & regmap_Mask(field)));
+}
+
+// Holds the write in the combine image when allowed, otherwise sends it after anything already held
+static bool regmap_Put(const RegMapDevice_t *dev, uint8_t reg, const uint8_t *data, uint8_t length, bool hold)
+{
+    uint8_t i;
+
+    if (hold && dev == combineDevice && (uint16_t)reg + length <= REGMAP_MASK_REGS)
+    {
+        for (i = 0; i < length; i++)
+        {
+            combineImage[reg + i] = data[i];
+            combinePending |= REGMAP_BIT(reg + i);
+        }
+        return true;
+    }
+    if (dev == combineDevice && !regmap_Commit())
+    {
+        return false;
+    }
+    return regmap_Send(dev, reg, data, length);
+}
+
+bool regmap_Read(const RegMapDevice_t *dev, uint8_t reg, uint8_t *data, uint8_t length)
+{
+    if (regmap_Held(dev, reg, length) && !regmap_Commit())                   // The read depends on a held write
+    {
+        return false;
+    }
+    return regmap_Complete(I2C1_WriteRead(dev->address, &reg, 1, data, length));
+}
+
+bool regmap_Write(const RegMapDevice_t *dev, uint8_t reg, const uint8_t *data, uint8_t length)
+{
+    return regmap_Put(dev, reg, data, length, true);
+}
+
+void regmap_Combine(const RegMapDevice_t *dev)
+{
+    regmap_Commit();
+    combineDevice = dev;
+}
+
+bool regmap_Commit(void)
+{
+    uint32_t pending = combinePending;
+    uint8_t start;
+    uint8_t reg = 0;
+    bool retStatus = true;
+
+    combinePending = 0;
+    while (pending && retStatus)
+    {
+        while (!(pending & REGMAP_BIT(reg)))
+        {
+            reg++;
+        }
+        start = reg;
+        while (reg < REGMAP_MASK_REGS && (pending & REGMAP_BIT(reg)))
+        {
+            pending &= ~REGMAP_BIT(reg);
+            reg++;
+        }
+        retStatus = regmap_Send(combineDevice, start, &combineImage[start], (uint8_t)(reg - start));
+    }
+    return retStatus;
+}
+
+bool regmap_ReadFields(const RegMapDevice_t *dev, const uint8_t *ids, uint8_t *values, uint8_t count)
+{
+    uint8_t image[REGMAP_SPAN_MAX];
+    uint8_t first;
+    uint8_t length;
+
+    if (!regmap_Span(dev, ids, count, &first, &length) || !regmap_Read(dev, first, image, length))
+    {
+        return false;
+    }
+    return regmap_Unpack(dev, ids, values, count, first, image, length);
+}
+
+bool regmap_WriteFields(const RegMapDevice_t *dev, const uint8_t *ids, const uint8_t *values, uint8_t count)
+{
+    uint8_t image[REGMAP_SPAN_MAX];
+    const RegField_t *field;
+    uint32_t touched = 0;                                                    // Bit n set when register first + n is targeted
+    uint8_t first;
+    uint8_t length;
+    uint8_t covered;
+    uint8_t defined;
+    uint8_t start = 0;
+    uint8_t end = 0;
+    uint8_t reg;
+    uint8_t i;
+    uint8_t j;
+    bool needRead = false;
+    bool open = false;
+    bool fresh = true;                                                       // Open run holds no volatile register that was read
+    bool retStatus = true;
+
+    if (!regmap_Span(dev, ids, count, &first, &length))
+    {
+        return false;
+    }
+
+    // A register needs reading only when the fields written leave some of its defined bits untouched
+    for (i = 0; i < count; i++)
+    {
+        reg = dev->fields[ids[i]].reg;
+        if (regmap_InMask(dev->noWrite, reg))
+        {
+            return false;
+        }
+        if (touched & REGMAP_BIT(reg - first))
+        {
+            continue;
+        }
+        touched |= REGMAP_BIT(reg - first);
+        covered = 0;
+        defined = 0;
+        for (j = 0; j < count; j++)
+        {
+            field = &dev->fields[ids[j]];
+            covered |= (field->reg == reg) ? regmap_Mask(field) : 0;
+        }
+        for (j = 0; j < dev->fieldCount; j++)
+        {
+            field = &dev->fields[j];
+            defined |= (field->reg == reg) ? regmap_Mask(field) : 0;
+        }
+        needRead |= (covered != defined);
+    }
+
+    if (needRead)
+    {
+        retStatus = regmap_Read(dev, first, image, length);
+    }
+    else
+    {
+        memset(image, 0, sizeof (image));
+    }
+    if (!retStatus)
+    {
+        return false;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        field = &dev->fields[ids[i]];
+        regmap_Place(field, values[i], &image[field->reg - first]);
+    }
+
+    // Untouched registers are carried inside a burst only if their read value can be safely written back
+    for (i = 0; i <= length && retStatus; i++)
+    {
+        reg = (uint8_t)(first + i);
+        if (i < length && (touched & REGMAP_BIT(i)))
+        {
+            fresh = open ? fresh : true;
+            fresh &= !(needRead && regmap_InMask(dev->volatileRegs, reg));
+            start = open ? start : i;
+            end = i;
+            open = true;
+        }
+        else if (open && (i == length || !needRead || regmap_InMask(dev->noWrite | dev->volatileRegs, reg)))
+        {
+            retStatus = regmap_Put(dev, (uint8_t)(first + start), &image[start], (uint8_t)(end - start + 1), fresh);
+            open = false;
+        }
+    }
+    return retStatus;
+}
+
+bool regmap_Pack(const RegMapDevice_t *dev, const uint8_t *ids, const uint8_t *values, uint8_t count, uint8_t first, uint8_t *image, uint8_t length)
+{
+    const RegField_t *field;
+    uint8_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (ids[i] >= dev->fieldCount)
+        {
+            return false;
+        }
+        field = &dev->fields[ids[i]];
+        if (field->reg < first || field->reg >= (uint16_t)first + length)
+        {
+            return false;
+        }
+        regmap_Place(field, values[i], &image[field->reg - first]);
+    }
+    return true;
+}
+
+bool regmap_Unpack(const RegMapDevice_t *dev, const uint8_t *ids, uint8_t *values, uint8_t count, uint8_t first, const uint8_t *image, uint8_t length)
+{
+    const RegField_t *field;
+    uint8_t raw;
+    uint8_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (ids[i] >= dev->fieldCount)
+        {
+            return false;
+        }
+        field = &dev->fields[ids[i]];
+        if (field->reg < first || field->reg >= (uint16_t)first + length)
+        {
+            return false;
+        }
+        raw = (uint8_t)((image[field->reg - first] & regmap_Mask(field)) >> field->shift);
+        if (field->bcd && !IS_BCD(raw))
+        {
+            return false;                                                    // Corrupted register, not a number
+        }
+        values[i] = field->bcd ? (uint8_t)((raw & 0x0F) + (raw >> 4) * 10) : raw;
+    }
+    return true;
+}
+
+uint8_t regmap_ReadField(const RegMapDevice_t *dev, uint8_t id)
+{
+    uint8_t value = 0;
+    regmap_ReadFields(dev, &id, &value, 1);
+    return value;
+}
+
+bool regmap_WriteField(const RegMapDevice_t *dev, uint8_t id, uint8_t value)
+{
+    return regmap_WriteFields(dev, &id, &value, 1);
+}
@@ -0,0 +1,211 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   
+ * Author: 
+ * Comments:
+ * Revision history: 
+ */
+
+
+/* 
+ * File:   regmap.h
+ * Author: 
+ * Comments: Table driven register map for I2C devices with auto-increment addressing
+ * Revision history: 
+ */
+
+#ifndef REGMAP_H
+#define	REGMAP_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// include files
+#include <stdint.h>
+#include <stdbool.h>
+
+#define REGMAP_SPAN_MAX             (32)                                      //  Largest burst, in registers
+#define REGMAP_MASK_REGS            (32)                                      //  Registers covered by the noWrite/volatile masks
+#define REGMAP_BIT(reg)             (1UL << (reg))
+
+// Expands one row of a device field list, see rtcc_map.h
+#define REGMAP_FIELD_ENUM(name, reg, shift, width, bcd)     FIELD_##name,
+#define REGMAP_FIELD_ENTRY(name, reg, shift, width, bcd)    {(reg), (shift), (width), (bcd)},
+
+typedef struct {
+    uint8_t reg;                                                             // Register address
+    uint8_t shift;                                                           // Position of the lowest bit
+    uint8_t width;                                                           // Number of bits
+    uint8_t bcd;                                                             // Value is held as packed BCD
+} RegField_t;
+
+typedef struct {
+    uint8_t address;                                                         // 7-bit I2C address
+    const RegField_t *fields;                                                // Indexed by the field enumeration
+    uint8_t fieldCount;
+    uint32_t noWrite;                                                        // Reserved, read-only or unlock registers
+    uint32_t volatileRegs;                                                   // Registers the device updates by itself
+} RegMapDevice_t;
+
+/**
+   @Param
+    device, first register, buffer, number of registers
+   @Returns
+    true when the transaction completed
+   @Description
+    Reads consecutive registers in one transaction
+   @Example
+    regmap_Read(&MCP79410_Device, 0x20, buffer, 4);
+ */
+bool regmap_Read(const RegMapDevice_t *dev, uint8_t reg, uint8_t *data, uint8_t length);
+
+/**
+   @Param
+    device, first register, buffer, number of registers
+   @Returns
+    true when the transaction completed
+   @Description
+    Writes consecutive registers in one transaction, or holds them when the
+    device is being combined
+   @Example
+    regmap_Write(&MCP79410_Device, 0x20, buffer, 4);
+ */
+bool regmap_Write(const RegMapDevice_t *dev, uint8_t reg, const uint8_t *data, uint8_t length);
+
+/**
+   @Param
+    device to combine, NULL to send every write straight away
+   @Returns
+    none
+   @Description
+    Commits anything held for the previous device, then holds the writes to
+    the first REGMAP_MASK_REGS registers of this device until regmap_Commit()
+    or a read of a held register
+   @Example
+    regmap_Combine(&MCP79410_Device);
+ */
+void regmap_Combine(const RegMapDevice_t *dev);
+
+/**
+   @Param
+    none
+   @Returns
+    true when every held write completed
+   @Description
+    Sends the held registers, one burst per contiguous run
+   @Example
+    none
+ */
+bool regmap_Commit(void);
+
+/**
+   @Param
+    device, field identifiers, destination for the decoded values, number of fields
+   @Returns
+    true when the transaction completed
+   @Description
+    Reads every register spanned by the fields in one burst and extracts
+    the fields, converting BCD fields to binary. Fails on a BCD field
+    holding a digit above 9.
+   @Example
+    none
+ */
+bool regmap_ReadFields(const RegMapDevice_t *dev, const uint8_t *ids, uint8_t *values, uint8_t count);
+
+/**
+   @Param
+    device, field identifiers, binary values, number of fields
+   @Returns
+    true when every transaction completed
+   @Description
+    Updates the fields with at most one burst read, needed only when a
+    register is partly covered, and one burst write per run of registers
+    that can be written together. Registers in noWrite are never written
+    and volatile registers are written only when a field targets them.
+    With combining, a true result can mean the write is still held.
+   @Example
+    none
+ */
+bool regmap_WriteFields(const RegMapDevice_t *dev, const uint8_t *ids, const uint8_t *values, uint8_t count);
+
+/**
+   @Param
+    device, field identifiers, binary values, number of fields, register of
+    image[0], register image, number of registers in the image
+   @Returns
+    false when a field lies outside the image
+   @Description
+    Encodes fields into a caller owned register image without any bus
+    traffic, bits not covered keep their value. The image can be built once
+    and sent with regmap_Write() as often as needed.
+   @Example
+    none
+ */
+bool regmap_Pack(const RegMapDevice_t *dev, const uint8_t *ids, const uint8_t *values, uint8_t count, uint8_t first, uint8_t *image, uint8_t length);
+
+/**
+   @Param
+    device, field identifiers, destination for the binary values, number of
+    fields, register of image[0], register image, number of registers
+   @Returns
+    false when a field lies outside the image or holds an invalid BCD digit
+   @Description
+    Decodes fields from a register image already read, so one burst can
+    serve several decodes
+   @Example
+    none
+ */
+bool regmap_Unpack(const RegMapDevice_t *dev, const uint8_t *ids, uint8_t *values, uint8_t count, uint8_t first, const uint8_t *image, uint8_t length);
+
+/**
+   @Param
+    device, field identifier
+   @Returns
+    decoded field value, zero when the read failed
+   @Description
+    Reads a single field
+   @Example
+    none
+ */
+uint8_t regmap_ReadField(const RegMapDevice_t *dev, uint8_t id);
+
+/**
+   @Param
+    device, field identifier, binary value
+   @Returns
+    true when every transaction completed
+   @Description
+    Writes a single field, reading the register first only if other
+    fields share it
+   @Example
+    none
+ */
+bool regmap_WriteField(const RegMapDevice_t *dev, uint8_t id, uint8_t value);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* REGMAP_H */
+
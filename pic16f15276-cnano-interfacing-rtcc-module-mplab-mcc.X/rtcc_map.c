@@ -0,0 +1,28 @@
+/*
+ * File:   rtcc_map.c
+ *
+ * Descriptor tables for the supported RTCC parts, expanded from the field
+ * lists in rtcc_map.h.
+ */
+
+/*
+ ***********************************************************
+ *                                                         *
+ *                  Include Header Files                   *
+ *                                                         *
+ ***********************************************************
+*/
+#include "rtcc_map.h"
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              User Defined Variables                     *
+ *                                                         *
+ ***********************************************************
+*/
+const RegField_t MCP7941x_Fields[FIELD_COUNT] = {
+    MCP7941X_FIELDS(REGMAP_FIELD_ENTRY)
+};
+
+const RegMapDevice_t MCP79410_Device = MCP7941X_DEVICE(MCP7941X_ADDR);
@@ -0,0 +1,140 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   
+ * Author: 
+ * Comments:
+ * Revision history: 
+ */
+
+
+/* 
+ * File:   rtcc_map.h
+ * Author: 
+ * Comments: Register layouts of the supported RTCC parts
+ * Revision history: 
+ */
+
+#ifndef RTCC_MAP_H
+#define	RTCC_MAP_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// include files
+#include "regmap.h"
+
+#ifndef MCP7941X_ADDR
+#define MCP7941X_ADDR               (0x6F)                                    //  RTCC REGISTER ADDRESS, fixed in the part, override for an address translator
+#endif
+
+// 0x09 is EEUNLOCK on the MCP79410 and reserved on the MCP7940N, 0x10 and 0x17 are reserved,
+// 0x18-0x1F hold the power fail time stamps and are read only
+#define MCP7941X_NO_WRITE           (REGMAP_BIT(0x09) | REGMAP_BIT(0x10) | REGMAP_BIT(0x17) | 0xFF000000UL)
+
+// Time keeping registers tick and the alarm weekday registers carry the hardware set interrupt flag
+#define MCP7941X_VOLATILE           (0x0000007FUL | REGMAP_BIT(0x0D) | REGMAP_BIT(0x14))
+
+// Initializer for one more MCP7941x behind a translator or a bus switch at another address
+#define MCP7941X_DEVICE(address)    {(address), MCP7941x_Fields, FIELD_COUNT, MCP7941X_NO_WRITE, MCP7941X_VOLATILE}
+
+// Register addresses used as burst starting points
+#define RTCC_SECONDS                (0x00)                                    //  Seconds..Year, seven registers
+#define RTCC_ALM0SEC                (0x0A)                                    //  ALM0SEC..ALM0MTH, six registers
+#define RTCC_ALM1SEC                (0x11)                                    //  ALM1SEC..ALM1MTH, same layout
+#define RTCC_SRAM                   (0x20)                                    //  64 bytes of battery backed SRAM
+
+/*
+ * MCP79410/MCP7940N field list: name, register, lowest bit, width, BCD.
+ * The list expands into the FIELD_xxx enumeration and the descriptor
+ * tables. A part with a different layout supplies its own list with the
+ * same names in the same order.
+ */
+#define MCP7941X_FIELDS(FIELD) \
+    FIELD(SECONDS,         0x00, 0, 7, 1) \
+    FIELD(ST,              0x00, 7, 1, 0) \
+    FIELD(MINUTES,         0x01, 0, 7, 1) \
+    FIELD(HOURS,           0x02, 0, 6, 1) \
+    FIELD(HOUR_12,         0x02, 6, 1, 0) \
+    FIELD(WEEKDAY,         0x03, 0, 3, 0) \
+    FIELD(VBATEN,          0x03, 3, 1, 0) \
+    FIELD(PWRFAIL,         0x03, 4, 1, 0) \
+    FIELD(OSCRUN,          0x03, 5, 1, 0) \
+    FIELD(DATE,            0x04, 0, 6, 1) \
+    FIELD(MONTH,           0x05, 0, 5, 1) \
+    FIELD(LPYR,            0x05, 5, 1, 0) \
+    FIELD(YEAR,            0x06, 0, 8, 1) \
+    FIELD(SQWFS,           0x07, 0, 2, 0) \
+    FIELD(CRSTRIM,         0x07, 2, 1, 0) \
+    FIELD(EXTOSC,          0x07, 3, 1, 0) \
+    FIELD(ALM0EN,          0x07, 4, 1, 0) \
+    FIELD(ALM1EN,          0x07, 5, 1, 0) \
+    FIELD(SQWEN,           0x07, 6, 1, 0) \
+    FIELD(OUT,             0x07, 7, 1, 0) \
+    FIELD(OSCTRIM,         0x08, 0, 8, 0) \
+    FIELD(ALM0_SECONDS,    0x0A, 0, 7, 1) \
+    FIELD(ALM0_MINUTES,    0x0B, 0, 7, 1) \
+    FIELD(ALM0_HOURS,      0x0C, 0, 6, 1) \
+    FIELD(ALM0_WEEKDAY,    0x0D, 0, 3, 0) \
+    FIELD(ALM0_IF,         0x0D, 3, 1, 0) \
+    FIELD(ALM0_MSK,        0x0D, 4, 3, 0) \
+    FIELD(ALM0_POL,        0x0D, 7, 1, 0) \
+    FIELD(ALM0_DATE,       0x0E, 0, 6, 1) \
+    FIELD(ALM0_MONTH,      0x0F, 0, 5, 1) \
+    FIELD(ALM1_SECONDS,    0x11, 0, 7, 1) \
+    FIELD(ALM1_MINUTES,    0x12, 0, 7, 1) \
+    FIELD(ALM1_HOURS,      0x13, 0, 6, 1) \
+    FIELD(ALM1_WEEKDAY,    0x14, 0, 3, 0) \
+    FIELD(ALM1_IF,         0x14, 3, 1, 0) \
+    FIELD(ALM1_MSK,        0x14, 4, 3, 0) \
+    FIELD(ALM1_POL,        0x14, 7, 1, 0) \
+    FIELD(ALM1_DATE,       0x15, 0, 6, 1) \
+    FIELD(ALM1_MONTH,      0x16, 0, 5, 1) \
+    FIELD(PWRDN_MINUTES,   0x18, 0, 7, 1) \
+    FIELD(PWRDN_HOURS,     0x19, 0, 6, 1) \
+    FIELD(PWRDN_DATE,      0x1A, 0, 6, 1) \
+    FIELD(PWRDN_MONTH,     0x1B, 0, 5, 1) \
+    FIELD(PWRDN_WEEKDAY,   0x1B, 5, 3, 0) \
+    FIELD(PWRUP_MINUTES,   0x1C, 0, 7, 1) \
+    FIELD(PWRUP_HOURS,     0x1D, 0, 6, 1) \
+    FIELD(PWRUP_DATE,      0x1E, 0, 6, 1) \
+    FIELD(PWRUP_MONTH,     0x1F, 0, 5, 1) \
+    FIELD(PWRUP_WEEKDAY,   0x1F, 5, 3, 0)
+
+typedef enum {
+    MCP7941X_FIELDS(REGMAP_FIELD_ENUM)
+    FIELD_COUNT
+} RtccField_t;
+
+// Alarm 1 fields follow the alarm 0 fields in the same order
+#define FIELD_ALARM_STRIDE          (FIELD_ALM1_SECONDS - FIELD_ALM0_SECONDS)
+
+extern const RegField_t MCP7941x_Fields[FIELD_COUNT];
+extern const RegMapDevice_t MCP79410_Device;                                 // Also drives the MCP7940N, same registers without the EEPROM
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* RTCC_MAP_H */
+
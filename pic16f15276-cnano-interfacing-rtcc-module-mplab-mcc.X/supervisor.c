@@ -0,0 +1,204 @@
+/*
+ * File:   supervisor.c
+ *
+ * The watchdog runs under software control (WDTE = SWDTEN) and is only
+ * cleared from the main loop once every task has reported a checkpoint,
+ * and no sooner than SUPERVISOR_WINDOW_MS after the previous clear. The
+ * checkpoints seen so far survive the reset in a persistent variable, so
+ * after a watchdog reset the record tells which task stopped.
+ *
+ * What this catches: a task that stops reporting for a watchdog period,
+ * and a console prompt that holds up the main loop for longer than
+ * SUPERVISOR_WAIT_MS. What it does not: the WDT of this part is not
+ * windowed, so the window only rate limits the clears and a loop that
+ * runs too fast is never reset; nor is a task that reports its
+ * checkpoint without getting its work done.
+ */
+
+/*
+ ***********************************************************
+ *                                                         *
+ *                  Include Header Files                   *
+ *                                                         *
+ ***********************************************************
+*/
+#include <xc.h>
+#include <string.h>
+#include "supervisor.h"
+#include "application.h"
+#include "console.h"
+#include "systime.h"
+
+#define RECORD_CHECK_SEED           (0xA5)
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              User Defined Variables                     *
+ *                                                         *
+ ***********************************************************
+*/
+static __persistent uint8_t supSeen;                                         // Not cleared by the C startup code
+static uint8_t supExpected;
+static uint32_t supCleared;                                                  // systime_Millis() at the last clear
+static uint32_t supPassed;                                                   // systime_Millis() when every checkpoint was last seen
+static SupervisorRecord_t supRecord;
+
+static const char *const causeNames[SUPERVISOR_RESET_CAUSES] = {
+    "power on", "brown out", "MCLR", "watchdog", "stack", "RESET instruction", "other"
+};
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              Static Function Declarations               *
+ *                                                         *
+ ***********************************************************
+*/
+static uint8_t supervisor_Cause(void);
+static uint8_t supervisor_Check(const SupervisorRecord_t *record);
+static bool supervisor_Clear(uint32_t now);
+
+/*
+ ***********************************************************
+ *                                                         *
+ *          User Defined Function Definitions              *
+ *                                                         *
+ ***********************************************************
+*/
+
+// The reset flags are active low except the stack flags
+static uint8_t supervisor_Cause(void)
+{
+    if (!PCON0bits.nPOR)
+    {
+        return SUPERVISOR_RESET_POWER_ON;
+    }
+    if (!PCON0bits.nBOR)
+    {
+        return SUPERVISOR_RESET_BROWN_OUT;
+    }
+    if (!PCON0bits.nRWDT)
+    {
+        return SUPERVISOR_RESET_WATCHDOG;
+    }
+    if (PCON0bits.STKOVF || PCON0bits.STKUNF)
+    {
+        return SUPERVISOR_RESET_STACK;
+    }
+    if (!PCON0bits.nRI)
+    {
+        return SUPERVISOR_RESET_INSTRUCTION;
+    }
+    if (!PCON0bits.nRMCLR)
+    {
+        return SUPERVISOR_RESET_MCLR;
+    }
+    return SUPERVISOR_RESET_OTHER;
+}
+
+static uint8_t supervisor_Check(const SupervisorRecord_t *record)
+{
+    const uint8_t *byte = (const uint8_t *)record;
+    uint8_t check = RECORD_CHECK_SEED;
+    uint8_t index;
+
+    for (index = 0; index < sizeof (SupervisorRecord_t); index++)
+    {
+        check ^= byte[index];
+    }
+    return check;
+}
+
+static bool supervisor_Clear(uint32_t now)
+{
+    if (now - supCleared < SUPERVISOR_WINDOW_MS)
+    {
+        return false;
+    }
+    CLRWDT();
+    supCleared = now;
+    supSeen = 0;
+    return true;
+}
+
+void supervisor_Initialize(uint8_t expected)
+{
+    supRecord.cause = supervisor_Cause();
+    supRecord.missing = (supRecord.cause == SUPERVISOR_RESET_WATCHDOG) ? (uint8_t)(expected & ~supSeen) : 0;
+    supRecord.watchdogResets = 0;
+    PCON0 = 0x1F;                                                            // Re-arm nRWDT, nRMCLR, nRI, nPOR, nBOR, clear the stack flags
+
+    supExpected = expected;
+    supSeen = 0;
+    supCleared = systime_Millis();
+    supPassed = supCleared;
+    WDTCONbits.WDTPS = SUPERVISOR_WDT_PERIOD;
+    CLRWDT();
+    WDTCONbits.SEN = 1;
+}
+
+void supervisor_Checkpoint(uint8_t check)
+{
+    supSeen |= check;
+}
+
+bool supervisor_Service(void)
+{
+    uint32_t now = systime_Millis();
+
+    if ((supSeen & supExpected) != supExpected)
+    {
+        return false;
+    }
+    supPassed = now;
+    return supervisor_Clear(now);
+}
+
+void supervisor_Wait(void)
+{
+    uint32_t now = systime_Millis();
+
+    supervisor_Checkpoint(SUPERVISOR_CHECK_CONSOLE);
+    if (now - supPassed < SUPERVISOR_WAIT_MS)                                // Parked in the prompt, not stuck
+    {
+        supervisor_Clear(now);
+    }
+}
+
+bool supervisor_Record(void)
+{
+    uint8_t stored[sizeof (SupervisorRecord_t) + 1];
+
+    if (rtc6_ReadSram(SRAM_SUPERVISOR, stored, sizeof (stored))
+        && supervisor_Check((const SupervisorRecord_t *)stored) == stored[sizeof (SupervisorRecord_t)])
+    {
+        supRecord.watchdogResets = ((const SupervisorRecord_t *)stored)->watchdogResets;
+    }
+    if (supRecord.cause == SUPERVISOR_RESET_WATCHDOG && supRecord.watchdogResets != UINT8_MAX)
+    {
+        supRecord.watchdogResets++;
+    }
+    memcpy(stored, &supRecord, sizeof (SupervisorRecord_t));
+    stored[sizeof (SupervisorRecord_t)] = supervisor_Check(&supRecord);
+    return rtc6_WriteSram(SRAM_SUPERVISOR, stored, sizeof (stored));
+}
+
+const SupervisorRecord_t *supervisor_Get(void)
+{
+    return &supRecord;
+}
+
+void supervisor_Report(void)
+{
+    console_PutString(" Last reset : ");
+    console_PutString(causeNames[supRecord.cause]);
+    if (supRecord.cause == SUPERVISOR_RESET_WATCHDOG)
+    {
+        console_PutString(", missing checkpoints ");
+        console_PutUnsigned(supRecord.missing, 0);
+    }
+    console_PutString(", watchdog resets ");
+    console_PutUnsigned(supRecord.watchdogResets, 0);
+    console_PutString("\n");
+}
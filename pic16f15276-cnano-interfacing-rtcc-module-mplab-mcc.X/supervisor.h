@@ -0,0 +1,174 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   
+ * Author: 
+ * Comments:
+ * Revision history: 
+ */
+
+
+/* 
+ * File:   supervisor.h
+ * Author: 
+ * Comments: Watchdog serviced from main loop checkpoints, reset cause kept in RTCC SRAM
+ * Revision history: 
+ */
+
+#ifndef SUPERVISOR_H
+#define	SUPERVISOR_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// include files
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SUPERVISOR_WDT_PERIOD       (0x0C)                                    //  WDTPS 1:131072, about 4 s, longer than any bounded wait
+#define SUPERVISOR_WINDOW_MS        (100)                                     //  Minimum time between two watchdog clears
+#define SUPERVISOR_WAIT_MS          (60000UL)                                 //  Longest a prompt may hold up the main loop
+
+// Progress checkpoints, each task reports its bit once per pass
+#define SUPERVISOR_CHECK_LOOP       (0x01)                                    //  main() loop completed a pass
+#define SUPERVISOR_CHECK_CONSOLE    (0x02)                                    //  rtc_Application() handled the console and alarms
+
+// Cause of the last reset, from PCON0
+#define SUPERVISOR_RESET_POWER_ON   (0)
+#define SUPERVISOR_RESET_BROWN_OUT  (1)
+#define SUPERVISOR_RESET_MCLR       (2)
+#define SUPERVISOR_RESET_WATCHDOG   (3)
+#define SUPERVISOR_RESET_STACK      (4)                                       //  Stack overflow or underflow
+#define SUPERVISOR_RESET_INSTRUCTION (5)                                      //  RESET instruction
+#define SUPERVISOR_RESET_OTHER      (6)
+#define SUPERVISOR_RESET_CAUSES     (7)
+
+// Kept in the RTCC SRAM at SRAM_SUPERVISOR
+typedef struct {
+    uint8_t cause;                                                           // SUPERVISOR_RESET_xxx of the last reset
+    uint8_t missing;                                                         // Checkpoints not reported before a watchdog reset
+    uint8_t watchdogResets;                                                  // Saturates at 255
+} SupervisorRecord_t;
+
+/**
+   @Param
+    checkpoints that must all be reported between two watchdog clears
+   @Returns
+    none
+   @Description
+    Reads and re-arms the reset flags in PCON0, then starts the watchdog.
+    Call first thing after SYSTEM_Initialize(); from here on every wait
+    has to be bounded or call supervisor_Wait().
+   @Example
+    supervisor_Initialize(SUPERVISOR_CHECK_LOOP | SUPERVISOR_CHECK_CONSOLE);
+ */
+void supervisor_Initialize(uint8_t expected);
+
+/**
+   @Param
+    SUPERVISOR_CHECK_xxx bit
+   @Returns
+    none
+   @Description
+    Reports that a task made progress
+   @Example
+    none
+ */
+void supervisor_Checkpoint(uint8_t check);
+
+/**
+   @Param
+    none
+   @Returns
+    true when the watchdog was cleared
+   @Description
+    Clears the watchdog when every expected checkpoint has been reported
+    and SUPERVISOR_WINDOW_MS has passed since the previous clear. A clear
+    that comes too early is only refused, it does not reset the device;
+    a loop that stops reporting, or that only calls this, is reset by the
+    watchdog. Call once per main loop pass.
+   @Example
+    none
+ */
+bool supervisor_Service(void);
+
+/**
+   @Param
+    none
+   @Returns
+    none
+   @Description
+    For loops that wait on the user, such as a console prompt. Reports
+    SUPERVISOR_CHECK_CONSOLE only; the main loop is excused for up to
+    SUPERVISOR_WAIT_MS after its last complete pass, then the watchdog
+    is left to expire and the record shows the loop checkpoint missing
+   @Example
+    while(!EUSART1_IsRxReady())
+    {
+        supervisor_Wait();
+    }
+ */
+void supervisor_Wait(void);
+
+/**
+   @Param
+    none
+   @Returns
+    true when the record reached the SRAM
+   @Description
+    Saves the reset cause in the RTCC SRAM and keeps the watchdog reset
+    count there. Call once the RTCC is initialized.
+   @Example
+    none
+ */
+bool supervisor_Record(void);
+
+/**
+   @Param
+    none
+   @Returns
+    record saved by supervisor_Record()
+   @Description
+    Last reset cause, missing checkpoints and watchdog reset count
+   @Example
+    none
+ */
+const SupervisorRecord_t *supervisor_Get(void);
+
+/**
+   @Param
+    none
+   @Returns
+    none
+   @Description
+    Prints the last reset cause on the console
+   @Example
+    none
+ */
+void supervisor_Report(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif
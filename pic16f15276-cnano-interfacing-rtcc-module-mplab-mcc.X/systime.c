@@ -0,0 +1,127 @@
+/*
+ * File:   systime.c
+ *
+ * Every delay and timeout goes through the selected clock. On the target
+ * the milliseconds come from the free-running Timer1, so they count even
+ * before the RTCC square wave runs. Host builds with SYSTIME_VIRTUAL add a
+ * virtual clock that only moves through delays and systime_Advance(), so
+ * a simulation runs long spans of device time without waiting for them;
+ * its bus model has to advance the clock while it is busy, or a timeout
+ * never expires.
+ */
+
+/*
+ ***********************************************************
+ *                                                         *
+ *                  Include Header Files                   *
+ *                                                         *
+ ***********************************************************
+*/
+#include <xc.h>
+#include "systime.h"
+#include "mcc_generated_files/system/system.h"
+
+#define COUNTS_PER_MS               (uint16_t)(TMR1_NOMINAL_FREQUENCY / 1000)
+#define FOLD_MASK                   (0x01FF)                                  //  Delay ms between Timer1 folds, well inside the 2.1 s wrap
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              Static Function Declarations               *
+ *                                                         *
+ ***********************************************************
+*/
+static uint32_t systime_TargetMillis(void);
+static void systime_TargetDelay(uint16_t ms);
+#if SYSTIME_VIRTUAL
+static uint32_t systime_VirtualMillis(void);
+static void systime_VirtualDelay(uint16_t ms);
+#endif
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              User Defined Variables                     *
+ *                                                         *
+ ***********************************************************
+*/
+const SysClock_t systime_TargetClock = {systime_TargetMillis, systime_TargetDelay};
+#if SYSTIME_VIRTUAL
+const SysClock_t systime_VirtualClock = {systime_VirtualMillis, systime_VirtualDelay};
+#endif
+
+static const SysClock_t *sysClock = &systime_TargetClock;
+static uint16_t sysLastCount;                                                // Timer1 at the previous read
+static uint16_t sysRemainder;                                                // Counts not yet worth a millisecond
+static uint32_t sysMillis;
+#if SYSTIME_VIRTUAL
+static uint32_t sysVirtualMillis;
+#endif
+
+/*
+ ***********************************************************
+ *                                                         *
+ *          User Defined Function Definitions              *
+ *                                                         *
+ ***********************************************************
+*/
+
+static uint32_t systime_TargetMillis(void)
+{
+    uint16_t count = TMR1_Read();
+    uint32_t counts = (uint32_t)(uint16_t)(count - sysLastCount) + sysRemainder;  // At most one Timer1 wrap between reads
+
+    sysLastCount = count;
+    sysMillis += counts / COUNTS_PER_MS;
+    sysRemainder = (uint16_t)(counts % COUNTS_PER_MS);
+    return sysMillis;
+}
+
+static void systime_TargetDelay(uint16_t ms)
+{
+    while (ms--)
+    {
+        __delay_ms(1);                                                       // __delay_ms() needs a constant
+        if ((ms & FOLD_MASK) == 0)
+        {
+            systime_TargetMillis();                                          // Folds Timer1 in before it can wrap
+        }
+    }
+}
+
+#if SYSTIME_VIRTUAL
+static uint32_t systime_VirtualMillis(void)
+{
+    return sysVirtualMillis;
+}
+
+static void systime_VirtualDelay(uint16_t ms)
+{
+    sysVirtualMillis += ms;
+}
+
+void systime_Use(const SysClock_t *clock)
+{
+    sysClock = clock;
+}
+
+void systime_Advance(uint32_t ms)
+{
+    sysVirtualMillis += ms;
+}
+#endif
+
+uint32_t systime_Millis(void)
+{
+    return sysClock->millis();
+}
+
+void systime_DelayMs(uint16_t ms)
+{
+    sysClock->delayMs(ms);
+}
+
+bool systime_Expired(uint32_t deadline)
+{
+    return (int32_t)(systime_Millis() - deadline) >= 0;
+}
@@ -0,0 +1,132 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   
+ * Author: 
+ * Comments:
+ * Revision history: 
+ */
+
+
+/* 
+ * File:   systime.h
+ * Author: 
+ * Comments: Pluggable millisecond clock behind every delay and timeout
+ * Revision history: 
+ */
+
+#ifndef SYSTIME_H
+#define	SYSTIME_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// include files
+#include <stdint.h>
+#include <stdbool.h>
+
+// Host builds set SYSTIME_VIRTUAL=1 for the simulated clock, see tools/fuzz
+#ifndef SYSTIME_VIRTUAL
+#define SYSTIME_VIRTUAL             (0)
+#endif
+
+typedef struct {
+    uint32_t (*millis)(void);                                                // Milliseconds since an arbitrary start
+    void (*delayMs)(uint16_t ms);
+} SysClock_t;
+
+extern const SysClock_t systime_TargetClock;                                 // Timer1 and __delay_ms
+#if SYSTIME_VIRTUAL
+extern const SysClock_t systime_VirtualClock;                                // Moves only when asked, delays return at once
+
+/**
+   @Param
+    clock to use from now on
+   @Returns
+    none
+   @Description
+    Selects the clock behind systime_Millis() and systime_DelayMs(). The
+    target clock is used until this is called.
+   @Example
+    systime_Use(&systime_VirtualClock);
+ */
+void systime_Use(const SysClock_t *clock);
+#endif
+
+/**
+   @Param
+    none
+   @Returns
+    milliseconds from the selected clock, wraps after 49 days
+   @Description
+    Time base for timeouts. The target clock extends Timer1 and has to be
+    read at least every 2 s to keep counting.
+   @Example
+    deadline = systime_Millis() + 10;
+ */
+uint32_t systime_Millis(void);
+
+/**
+   @Param
+    milliseconds
+   @Returns
+    none
+   @Description
+    Waits on the selected clock. The virtual clock just moves forward.
+   @Example
+    systime_DelayMs(HOLD_TIME);
+ */
+void systime_DelayMs(uint16_t ms);
+
+/**
+   @Param
+    deadline from systime_Millis()
+   @Returns
+    true once the deadline has passed, correct across the wrap
+   @Description
+    Checks a timeout started with systime_Millis() + duration
+   @Example
+    none
+ */
+bool systime_Expired(uint32_t deadline);
+
+#if SYSTIME_VIRTUAL
+/**
+   @Param
+    milliseconds
+   @Returns
+    none
+   @Description
+    Moves the virtual clock forward, e.g. to simulate days of device time
+   @Example
+    systime_Advance(86400000UL);
+ */
+void systime_Advance(uint32_t ms);
+#endif
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* SYSTIME_H */
+
@@ -0,0 +1,152 @@
+/*
+ * File:   timestamp.c
+ *
+ * The RTCC only counts whole seconds. Every rising edge of its 1 Hz
+ * square wave latches the free-running Timer1, and the Timer1 counts since
+ * that latch, scaled by the measured counts per second, give the
+ * milliseconds. Measuring the period each second removes the LFINTOSC
+ * tolerance from the result. When the edges stop (oscillator halted, no
+ * chip, MFP in alarm mode) the main loop marks the latch overdue before
+ * the 16-bit difference wraps, and the time holds at the end of the last
+ * second instead of running backwards.
+ */
+
+/*
+ ***********************************************************
+ *                                                         *
+ *                  Include Header Files                   *
+ *                                                         *
+ ***********************************************************
+*/
+#include <xc.h>
+#include "timestamp.h"
+#include "mcc_generated_files/system/system.h"
+
+#define PERIOD_MIN                  (uint16_t)(TMR1_NOMINAL_FREQUENCY * 3 / 4)  //  Edges closer or further apart than
+#define PERIOD_MAX                  (uint16_t)(TMR1_NOMINAL_FREQUENCY * 5 / 4)  //  this are glitches or missed edges
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              User Defined Variables                     *
+ *                                                         *
+ ***********************************************************
+*/
+static volatile uint32_t tsSeconds;                                          // UTC second started by the last edge
+static volatile uint32_t tsTicks;                                            // Edges since initialization
+static volatile uint16_t tsLatch;                                            // Timer1 at the last edge
+static volatile uint16_t tsPeriod = (uint16_t)TMR1_NOMINAL_FREQUENCY;        // Timer1 counts per second
+static volatile bool tsOverdue;                                              // No edge for a period, tsLatch no longer usable
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              Static Function Declarations               *
+ *                                                         *
+ ***********************************************************
+*/
+static uint32_t timestamp_Sample(uint32_t *ticks);
+
+/*
+ ***********************************************************
+ *                                                         *
+ *          User Defined Function Definitions              *
+ *                                                         *
+ ***********************************************************
+*/
+
+// Copies the edge state with the IOC interrupt held off and returns the UTC second; ticks is scaled to milliseconds
+static uint32_t timestamp_Sample(uint32_t *ticks)
+{
+    uint32_t seconds;
+    uint16_t latch;
+    uint16_t period;
+    uint16_t elapsed;
+    uint8_t iocEnabled = PIE0bits.IOCIE;
+
+    PIE0bits.IOCIE = 0;
+    seconds = tsSeconds;
+    *ticks = tsTicks;
+    latch = tsLatch;
+    period = tsPeriod;
+    elapsed = TMR1_Read() - latch;
+    if (tsOverdue || elapsed >= period)                                      // Edge overdue, hold at the end of the second
+    {
+        tsOverdue = true;
+        elapsed = period - 1;
+    }
+    PIE0bits.IOCIE = iocEnabled;
+
+    *ticks = *ticks * 1000 + (uint16_t)(((uint32_t)elapsed * 1000) / period);
+    return seconds;
+}
+
+void timestamp_Initialize(time_t now)
+{
+    uint8_t iocEnabled = PIE0bits.IOCIE;
+
+    PIE0bits.IOCIE = 0;
+    tsSeconds = (uint32_t)now;
+    tsTicks = 0;
+    tsLatch = TMR1_Read();
+    tsOverdue = false;
+    PIE0bits.IOCIE = iocEnabled;
+}
+
+void timestamp_Sync(time_t now)
+{
+    uint8_t iocEnabled = PIE0bits.IOCIE;
+
+    PIE0bits.IOCIE = 0;
+    tsSeconds = (uint32_t)now;
+    PIE0bits.IOCIE = iocEnabled;
+}
+
+void timestamp_Tick(uint16_t edge)
+{
+    uint16_t period = edge - tsLatch;
+
+    if (tsTicks != 0 && !tsOverdue && period >= PERIOD_MIN && period <= PERIOD_MAX)
+    {
+        tsPeriod = period;                                                   // After a gap the difference may have wrapped
+    }
+    tsOverdue = false;
+    tsLatch = edge;
+    tsSeconds++;
+    tsTicks++;
+}
+
+void timestamp_At(uint16_t timer, Timestamp_t *ts)
+{
+    uint16_t elapsed = timer - tsLatch;
+
+    if (tsOverdue || elapsed >= tsPeriod)
+    {
+        elapsed = tsPeriod - 1;
+    }
+    ts->seconds = tsSeconds;
+    ts->millis = (uint16_t)(((uint32_t)elapsed * 1000) / tsPeriod);
+}
+
+void timestamp_Now(Timestamp_t *ts)
+{
+    uint32_t millis;
+
+    ts->seconds = timestamp_Sample(&millis);
+    ts->millis = (uint16_t)(millis % 1000);
+}
+
+void timestamp_Service(void)
+{
+    uint32_t millis;
+
+    timestamp_Sample(&millis);                                               // Marks an overdue latch
+}
+
+uint32_t timestamp_Monotonic(void)
+{
+    uint32_t millis;
+
+    timestamp_Sample(&millis);
+    return millis;
+}
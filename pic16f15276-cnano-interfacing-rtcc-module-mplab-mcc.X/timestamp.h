@@ -0,0 +1,143 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   timestamp.h
+ * Author: 
+ * Comments: Millisecond timestamps from the RTCC 1 Hz edge and a free-running Timer1
+ * Revision history: 
+ */
+
+#ifndef TIMESTAMP_H
+#define	TIMESTAMP_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// include files
+#include <time.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    uint32_t seconds;                                                        // UTC epoch
+    uint16_t millis;                                                         // 0..999 since the last 1 Hz edge
+} Timestamp_t;
+
+/**
+   @Param
+    current RTCC time
+   @Returns
+    none
+   @Description
+    Starts the service at the given UTC second. Requires the RTCC MFP to
+    output the 1 Hz square wave on RB2.
+   @Example
+    timestamp_Initialize(rtc6_GetTime());
+ */
+void timestamp_Initialize(time_t now);
+
+/**
+   @Param
+    UTC time just written to or read from the RTCC
+   @Returns
+    none
+   @Description
+    Re-aligns the wall-clock seconds; the monotonic count is not affected
+   @Example
+    none
+ */
+void timestamp_Sync(time_t now);
+
+/**
+   @Param
+    Timer1 value at the edge
+   @Returns
+    none
+   @Description
+    Latches the edge time and advances the second. Called from the RB2
+    interrupt for every accepted pulse of the 1 Hz square wave.
+   @Example
+    none
+ */
+void timestamp_Tick(uint16_t edge);
+
+/**
+   @Param
+    Timer1 value, destination timestamp
+   @Returns
+    none
+   @Description
+    Wall-clock time of a Timer1 value taken within the current second, such
+    as an edge captured by CCP1. Called from the RB2 interrupt, where the
+    edge state cannot change underneath it.
+   @Example
+    none
+ */
+void timestamp_At(uint16_t timer, Timestamp_t *ts);
+
+/**
+   @Param
+    destination timestamp
+   @Returns
+    none
+   @Description
+    Wall-clock time with millisecond resolution
+   @Example
+    none
+ */
+void timestamp_Now(Timestamp_t *ts);
+
+/**
+   @Param
+    none
+   @Returns
+    none
+   @Description
+    Called from the main loop. Timer1 wraps about every 2.1 s, so when the
+    1 Hz edges stop the latch has to be marked overdue within about 1.1 s
+    of the missed edge; from then on the time holds at the end of the last
+    second until the edges return.
+   @Example
+    none
+ */
+void timestamp_Service(void);
+
+/**
+   @Param
+    none
+   @Returns
+    milliseconds since timestamp_Initialize()
+   @Description
+    Monotonic time for ordering events, unaffected by timestamp_Sync();
+    never decreases, holds while the 1 Hz edges are missing and wraps
+    after 49 days
+   @Example
+    none
+ */
+uint32_t timestamp_Monotonic(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,220 @@
+/*
+ * File:   timezone.c
+ *
+ * The RTCC keeps UTC. Local time is UTC plus the offset found in a small
+ * transition table built once per year from the configured DST rule, so
+ * rendering is a lookup, an add and a calendar split with no libc call.
+ */
+
+/*
+ ***********************************************************
+ *                                                         *
+ *                  Include Header Files                   *
+ *                                                         *
+ ***********************************************************
+*/
+#include <xc.h>
+#include <string.h>
+#include "timezone.h"
+#include "datetime.h"
+#include "application.h"
+
+#define SECONDS_PER_DAY             (86400UL)
+#define TRANSITIONS_MAX             (3)                                       //  Year start, DST start, DST end
+#define CONFIG_CHECK_SEED           (0x5A)
+
+typedef struct {
+    uint32_t utc;                                                            // First second this offset applies
+    int16_t offset;
+} transition_t;
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              User Defined Variables                     *
+ *                                                         *
+ ***********************************************************
+*/
+static TzConfig_t tzConfig;
+static transition_t tzTable[TRANSITIONS_MAX];                               // Sorted by utc
+static uint8_t tzCount;
+static uint32_t tzYearStart;                                                 // UTC window covered by tzTable
+static uint32_t tzYearEnd;
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              Static Function Declarations               *
+ *                                                         *
+ ***********************************************************
+*/
+static uint32_t timezone_RuleToUtc(uint8_t year, const TzRule_t *rule, int16_t offset);
+static void timezone_BuildTable(uint8_t year);
+static uint8_t timezone_Check(const TzConfig_t *config);
+static bool timezone_IsRuleValid(const TzRule_t *rule);
+static bool timezone_IsValid(const TzConfig_t *config);
+
+/*
+ ***********************************************************
+ *                                                         *
+ *          User Defined Function Definitions              *
+ *                                                         *
+ ***********************************************************
+*/
+
+// UTC instant of a rule in the given year; the rule time is local wall clock time at the given offset
+static uint32_t timezone_RuleToUtc(uint8_t year, const TzRule_t *rule, int16_t offset)
+{
+    uint16_t first = datetime_DaysFromCivil(year, rule->month, 1);
+    uint8_t monthLength = (uint8_t)(datetime_DaysFromCivil(year + (rule->month == 12), (rule->month % 12) + 1, 1) - first);
+    uint8_t day = (uint8_t)(1 + (rule->wday + 7 - (first + 4) % 7) % 7);  // 1970-01-01 was a Thursday
+
+    day += (uint8_t)(7 * (rule->week - 1));
+    while (day > monthLength)                                                // TIMEZONE_RULE_LAST
+    {
+        day -= 7;
+    }
+    return (uint32_t)(first + day - 1) * SECONDS_PER_DAY + (uint32_t)rule->minute * 60 - (int32_t)offset * 60;
+}
+
+static void timezone_BuildTable(uint8_t year)
+{
+    uint32_t start;
+    uint32_t end;
+
+    tzYearStart = (uint32_t)datetime_DaysFromCivil(year, 1, 1) * SECONDS_PER_DAY;
+    tzYearEnd = (year < 99) ? (uint32_t)datetime_DaysFromCivil(year + 1, 1, 1) * SECONDS_PER_DAY : UINT32_MAX;
+    tzTable[0].utc = 0;
+    tzTable[0].offset = tzConfig.offset;
+    tzCount = 1;
+    if (tzConfig.dstDelta != 0)
+    {
+        start = timezone_RuleToUtc(year, &tzConfig.start, tzConfig.offset);
+        end = timezone_RuleToUtc(year, &tzConfig.end, tzConfig.offset + tzConfig.dstDelta);
+        if (start < end)                                                     // Northern hemisphere: DST inside the year
+        {
+            tzTable[1].utc = start;
+            tzTable[1].offset = tzConfig.offset + tzConfig.dstDelta;
+            tzTable[2].utc = end;
+            tzTable[2].offset = tzConfig.offset;
+        }
+        else                                                                 // Southern hemisphere: DST spans the new year
+        {
+            tzTable[0].offset = tzConfig.offset + tzConfig.dstDelta;
+            tzTable[1].utc = end;
+            tzTable[1].offset = tzConfig.offset;
+            tzTable[2].utc = start;
+            tzTable[2].offset = tzConfig.offset + tzConfig.dstDelta;
+        }
+        tzCount = TRANSITIONS_MAX;
+    }
+}
+
+static uint8_t timezone_Check(const TzConfig_t *config)
+{
+    const uint8_t *byte = (const uint8_t *)config;
+    uint8_t check = CONFIG_CHECK_SEED;
+    uint8_t index;
+
+    for (index = 0; index < sizeof (TzConfig_t); index++)
+    {
+        check ^= byte[index];
+    }
+    return check;
+}
+
+static bool timezone_IsRuleValid(const TzRule_t *rule)
+{
+    return rule->month >= 1 && rule->month <= 12 && rule->week >= 1 && rule->week <= TIMEZONE_RULE_LAST
+        && rule->wday <= 6 && rule->minute < 1440;
+}
+
+// Range checks shared by the setter and the SRAM load, a rule month of 0 would index before the month table
+static bool timezone_IsValid(const TzConfig_t *config)
+{
+    if (config->offset < -720 || config->offset > 840 || config->dstDelta < 0 || config->dstDelta > 120)
+    {
+        return false;
+    }
+    return config->dstDelta == 0 || (timezone_IsRuleValid(&config->start) && timezone_IsRuleValid(&config->end));
+}
+
+void timezone_Initialize(void)
+{
+    uint8_t stored[sizeof (TzConfig_t) + 1];
+
+    memset(&tzConfig, 0, sizeof (tzConfig));
+    tzConfig.offset = TIMEZONE_DEFAULT_OFFSET;
+    if (rtc6_ReadSram(SRAM_TIMEZONE, stored, sizeof (stored)))
+    {
+        if (timezone_Check((const TzConfig_t *)stored) == stored[sizeof (TzConfig_t)])
+        {
+            memcpy(&tzConfig, stored, sizeof (TzConfig_t));
+            if (!timezone_IsValid(&tzConfig))
+            {
+                memset(&tzConfig, 0, sizeof (tzConfig));                     // Check byte matched a corrupted record, run on UTC
+            }
+        }
+    }
+    tzYearStart = 1;                                                         // Empty window forces a rebuild on first use
+    tzYearEnd = 0;
+}
+
+bool timezone_Configure(const TzConfig_t *config)
+{
+    uint8_t stored[sizeof (TzConfig_t) + 1];
+
+    if (!timezone_IsValid(config))
+    {
+        return false;
+    }
+    tzConfig = *config;
+    tzYearStart = 1;
+    tzYearEnd = 0;
+    memcpy(stored, config, sizeof (TzConfig_t));
+    stored[sizeof (TzConfig_t)] = timezone_Check(config);
+    return rtc6_WriteSram(SRAM_TIMEZONE, stored, sizeof (stored));
+}
+
+const TzConfig_t *timezone_Get(void)
+{
+    return &tzConfig;
+}
+
+int16_t timezone_Offset(uint32_t utc)
+{
+    DateTime_t dt;
+    uint8_t index;
+
+    if (utc < tzYearStart || utc >= tzYearEnd)
+    {
+        datetime_FromEpoch(utc, &dt);
+        timezone_BuildTable(dt.year);
+    }
+    index = tzCount - 1;
+    while (index != 0 && utc < tzTable[index].utc)
+    {
+        index--;
+    }
+    return tzTable[index].offset;
+}
+
+void timezone_ToLocal(uint32_t utc, struct tm *tm_t)
+{
+    int32_t local = (int32_t)timezone_Offset(utc) * 60;
+
+    if (local < 0 && utc < (uint32_t)(-local))
+    {
+        local = -(int32_t)utc;                                               // Clamp at the epoch
+    }
+    timezone_CivilFromEpoch(utc + (uint32_t)local, tm_t);
+    tm_t->tm_isdst = (tzConfig.dstDelta != 0 && local != (int32_t)tzConfig.offset * 60);
+}
+
+void timezone_CivilFromEpoch(uint32_t epoch, struct tm *tm_t)
+{
+    DateTime_t dt;
+
+    datetime_FromEpoch(epoch, &dt);
+    datetime_ToTm(&dt, tm_t);
+}
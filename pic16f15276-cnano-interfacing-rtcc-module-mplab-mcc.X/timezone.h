@@ -0,0 +1,139 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   timezone.h
+ * Author: 
+ * Comments: Local time rendering from the UTC clock: fixed offset plus optional DST rule
+ * Revision history: 
+ */
+
+#ifndef TIMEZONE_H
+#define	TIMEZONE_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// include files
+#include <time.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TIMEZONE_DEFAULT_OFFSET     (330)                                     //  IST, UTC+05:30, no DST
+#define TIMEZONE_RULE_LAST          (5)                                       //  week = 5 selects the last weekday of the month
+
+// DST transition: the given weekday of the given week of the month, at a local wall clock time
+typedef struct {
+    uint8_t month;                                                           // 1..12
+    uint8_t week;                                                            // 1..4, TIMEZONE_RULE_LAST
+    uint8_t wday;                                                            // 0 = Sunday
+    uint16_t minute;                                                         // Minute of the local day, 0..1439
+} TzRule_t;
+
+typedef struct {
+    int16_t offset;                                                          // Standard time, minutes east of UTC
+    int16_t dstDelta;                                                        // Minutes added while DST is active, 0 = no DST
+    TzRule_t start;                                                          // In local standard time
+    TzRule_t end;                                                            // In local daylight time
+} TzConfig_t;
+
+/**
+   @Param
+    none
+   @Returns
+    none
+   @Description
+    Loads the time zone from the RTCC SRAM, falling back to
+    TIMEZONE_DEFAULT_OFFSET when the SRAM holds no configuration. A record
+    whose check byte matches but whose values fail the timezone_Configure()
+    range checks is treated as corrupted and replaced by UTC.
+   @Example
+    none
+ */
+void timezone_Initialize(void);
+
+/**
+   @Param
+    time zone configuration
+   @Returns
+    true when the configuration is valid and was stored
+   @Description
+    Validates, applies and stores the configuration in the RTCC SRAM
+   @Example
+    none
+ */
+bool timezone_Configure(const TzConfig_t *config);
+
+/**
+   @Param
+    none
+   @Returns
+    active configuration
+   @Description
+    Gives read access to the configuration in use
+   @Example
+    none
+ */
+const TzConfig_t *timezone_Get(void);
+
+/**
+   @Param
+    UTC epoch
+   @Returns
+    offset in minutes east of UTC
+   @Description
+    Looks the offset up in the transition table of the epoch's year; the
+    table is rebuilt only when the year changes
+   @Example
+    none
+ */
+int16_t timezone_Offset(uint32_t utc);
+
+/**
+   @Param
+    UTC epoch, destination time structure
+   @Returns
+    none
+   @Description
+    Renders the local calendar time without localtime()
+   @Example
+    none
+ */
+void timezone_ToLocal(uint32_t utc, struct tm *tm_t);
+
+/**
+   @Param
+    epoch from 2000-01-01 onwards, destination time structure
+   @Returns
+    none
+   @Description
+    Converts an epoch to calendar fields (valid for 2000..2099)
+   @Example
+    none
+ */
+void timezone_CivilFromEpoch(uint32_t epoch, struct tm *tm_t);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif
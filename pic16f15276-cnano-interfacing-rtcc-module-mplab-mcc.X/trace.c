@@ -0,0 +1,82 @@
+/*
+ * File:   trace.c
+ *
+ * Fixed size trace records in a RAM ring: event, data byte and the
+ * Timer1 count, which wraps every 2.1 s and is unwrapped by the decoder.
+ */
+
+/*
+ ***********************************************************
+ *                                                         *
+ *                  Include Header Files                   *
+ *                                                         *
+ ***********************************************************
+*/
+#include <xc.h>
+#include "trace.h"
+#include "console.h"
+#include "mcc_generated_files/system/system.h"
+
+typedef struct {
+    uint8_t event;
+    uint8_t data;
+    uint16_t time;                                                           // Timer1 count
+} TraceRecord_t;
+
+/*
+ ***********************************************************
+ *                                                         *
+ *              User Defined Variables                     *
+ *                                                         *
+ ***********************************************************
+*/
+static TraceRecord_t traceBuffer[TRACE_RECORDS];
+static uint8_t traceHead;                                                    // Next record to write
+static uint8_t traceCount;
+static bool tracePaused;
+
+/*
+ ***********************************************************
+ *                                                         *
+ *          User Defined Function Definitions              *
+ *                                                         *
+ ***********************************************************
+*/
+
+void trace_Record(uint8_t event, uint8_t data)
+{
+    TraceRecord_t *record = &traceBuffer[traceHead];
+
+    if (tracePaused)
+    {
+        return;
+    }
+    record->event = event;
+    record->data = data;
+    record->time = TMR1_Read();
+    traceHead = (uint8_t)((traceHead + 1) % TRACE_RECORDS);
+    traceCount = (traceCount < TRACE_RECORDS) ? (uint8_t)(traceCount + 1) : traceCount;
+}
+
+void trace_Dump(void)
+{
+    uint8_t index = (uint8_t)((traceHead + TRACE_RECORDS - traceCount) % TRACE_RECORDS);
+    uint8_t i;
+
+    tracePaused = true;
+    console_PutString("\nTRACE ");
+    console_PutUnsigned(traceCount, 0);
+    console_PutString("\r\n");
+    for (i = 0; i < traceCount; i++)
+    {
+        console_PutHex(traceBuffer[index].event);
+        console_PutHex(traceBuffer[index].data);
+        console_PutHex((uint8_t)(traceBuffer[index].time >> 8));
+        console_PutHex((uint8_t)traceBuffer[index].time);
+        console_PutString("\r\n");
+        index = (uint8_t)((index + 1) % TRACE_RECORDS);
+    }
+    console_PutString("END\r\n");
+    traceCount = 0;
+    tracePaused = false;
+}
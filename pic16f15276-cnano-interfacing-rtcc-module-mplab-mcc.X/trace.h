@@ -0,0 +1,102 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   
+ * Author: 
+ * Comments:
+ * Revision history: 
+ */
+
+
+/* 
+ * File:   trace.h
+ * Author: 
+ * Comments: RAM ring buffer trace of I2C and EUSART activity, decoded by tools/trace_decode.py
+ * Revision history: 
+ */
+
+#ifndef TRACE_H
+#define	TRACE_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// include files
+#include <stdint.h>
+#include <stdbool.h>
+
+// Build with TRACE_ENABLE=1 in the project macros to record traces
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE                (0)
+#endif
+
+#define TRACE_RECORDS               (64)                                      //  Four bytes each, oldest records are overwritten
+
+// Record events, the data byte is given after each
+#define TRACE_I2C_START             (0x01)                                    //  7-bit client address
+#define TRACE_I2C_STATE             (0x02)                                    //  i2c_host_event_states_t entered
+#define TRACE_I2C_ERROR             (0x03)                                    //  i2c_host_error_t
+#define TRACE_UART_RX               (0x04)                                    //  Byte read
+#define TRACE_UART_TX               (0x05)                                    //  Byte queued
+#define TRACE_UART_TX_BLOCK         (0x06)                                    //  Number of bytes queued by one EUSART1_WriteBuffer()
+
+#if TRACE_ENABLE
+#define TRACE(event, data)          trace_Record((event), (uint8_t)(data))
+#else
+#define TRACE(event, data)
+#endif
+
+/**
+   @Param
+    TRACE_xxx event, data byte
+   @Returns
+    none
+   @Description
+    Appends a record stamped with Timer1. Called from the main loop only,
+    the I2C state machine is polled and the UART hooks are outside the
+    transmit interrupt.
+   @Example
+    TRACE(TRACE_UART_RX, data);
+ */
+void trace_Record(uint8_t event, uint8_t data);
+
+/**
+   @Param
+    none
+   @Returns
+    none
+   @Description
+    Prints the buffer oldest first as "TRACE n", n lines of eight hex
+    digits (event, data, Timer1) and "END", then empties it. Recording is
+    paused while the dump is written so it does not trace itself.
+   @Example
+    none
+ */
+void trace_Dump(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* TRACE_H */
+
@@ -0,0 +1,169 @@
+/*
+ * File:   console_bench.c
+ *
+ * Host check of the console formatter against the snprintf calls it
+ * replaced. Each case renders the same values both ways and aborts when
+ * the text differs, then prints the host time per call of each. The host
+ * divides in hardware and the two run at about the same speed, so the
+ * times only catch a formatter that became much slower; flash and cycles
+ * on the PIC are not measured here.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "console.h"
+#include "datetime.h"
+#include "timezone.h"
+
+#define BENCH_RUNS                  (1000000UL)
+#define BENCH_TEXT_MAX              (64)                                      //  Room for any int the snprintf format can see
+
+static char benchText[BENCH_TEXT_MAX];                                       // Last text sent to the UART stub
+static uint8_t benchLength;
+
+/*
+ * The UART and the SRAM are not needed by the formatter; the stubs keep
+ * the console output for comparison and satisfy the time zone module.
+ */
+void EUSART1_Write(uint8_t txData)
+{
+    benchText[0] = (char)txData;
+    benchLength = 1;
+}
+
+void EUSART1_WriteBuffer(const uint8_t *txData, uint8_t length)
+{
+    memcpy(benchText, txData, length);
+    benchLength = length;
+}
+
+bool rtc6_ReadSram(uint8_t offset, uint8_t *data, uint8_t length)
+{
+    return false;
+}
+
+bool rtc6_WriteSram(uint8_t offset, const uint8_t *data, uint8_t length)
+{
+    return false;
+}
+
+static double bench_Seconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+// xorshift32, so both sides of a case see the same values
+static uint32_t bench_Next(uint32_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static void bench_Compare(const char *name, const char *expected, const char *actual, uint8_t length)
+{
+    if (strlen(expected) != length || memcmp(expected, actual, length) != 0)
+    {
+        fprintf(stderr, "%s: console gave \"%.*s\", snprintf \"%s\"\n", name, length, actual, expected);
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void bench_Report(const char *name, double console, double reference)
+{
+    printf("%-12s %lu values identical, host time per call: console %.1f ns, snprintf %.1f ns\n", name,
+           BENCH_RUNS / 100, console * 1e9 / BENCH_RUNS, reference * 1e9 / BENCH_RUNS);
+}
+
+static void bench_Unsigned(void)
+{
+    char expected[BENCH_TEXT_MAX];
+    uint32_t state = 1;
+    uint32_t value;
+    unsigned long run;
+    double start;
+    double console;
+
+    for (run = 0; run < BENCH_RUNS / 100; run++)
+    {
+        value = bench_Next(&state) >> (run % 32);
+        console_PutUnsigned(value, 4);
+        snprintf(expected, sizeof (expected), "%04lu", (unsigned long)value);
+        bench_Compare("unsigned", expected, benchText, benchLength);
+    }
+
+    state = 1;
+    start = bench_Seconds();
+    for (run = 0; run < BENCH_RUNS; run++)
+    {
+        console_PutUnsigned(bench_Next(&state) >> (run % 32), 4);
+    }
+    console = bench_Seconds() - start;
+
+    state = 1;
+    start = bench_Seconds();
+    for (run = 0; run < BENCH_RUNS; run++)
+    {
+        benchLength = (uint8_t)snprintf(benchText, sizeof (benchText), "%04lu", (unsigned long)(bench_Next(&state) >> (run % 32)));
+    }
+    bench_Report("unsigned", console, bench_Seconds() - start);
+}
+
+static void bench_Iso8601(void)
+{
+    char expected[BENCH_TEXT_MAX];
+    char actual[BENCH_TEXT_MAX];
+    Timestamp_t ts;
+    struct tm tm_t;
+    uint32_t state = 1;
+    unsigned long run;
+    double start;
+    double console;
+
+    for (run = 0; run < BENCH_RUNS / 100; run++)
+    {
+        ts.seconds = DATETIME_EPOCH_MIN + bench_Next(&state) % (DATETIME_EPOCH_MAX - DATETIME_EPOCH_MIN + 1);
+        ts.millis = (uint16_t)(bench_Next(&state) % 1000);
+        timezone_CivilFromEpoch(ts.seconds, &tm_t);
+        snprintf(expected, sizeof (expected), "%04d-%02d-%02dT%02d:%02d:%02d.%03uZ", tm_t.tm_year + 1900, tm_t.tm_mon + 1,
+                 tm_t.tm_mday, tm_t.tm_hour, tm_t.tm_min, tm_t.tm_sec, (unsigned)ts.millis);
+        bench_Compare("iso8601", expected, actual, console_FormatIso8601(actual, &ts));
+    }
+
+    state = 1;
+    start = bench_Seconds();
+    for (run = 0; run < BENCH_RUNS; run++)
+    {
+        ts.seconds = DATETIME_EPOCH_MIN + bench_Next(&state) % (DATETIME_EPOCH_MAX - DATETIME_EPOCH_MIN + 1);
+        ts.millis = (uint16_t)(bench_Next(&state) % 1000);
+        benchLength = console_FormatIso8601(benchText, &ts);
+    }
+    console = bench_Seconds() - start;
+
+    state = 1;
+    start = bench_Seconds();
+    for (run = 0; run < BENCH_RUNS; run++)
+    {
+        ts.seconds = DATETIME_EPOCH_MIN + bench_Next(&state) % (DATETIME_EPOCH_MAX - DATETIME_EPOCH_MIN + 1);
+        ts.millis = (uint16_t)(bench_Next(&state) % 1000);
+        timezone_CivilFromEpoch(ts.seconds, &tm_t);
+        benchLength = (uint8_t)snprintf(benchText, sizeof (benchText), "%04d-%02d-%02dT%02d:%02d:%02d.%03uZ", tm_t.tm_year + 1900,
+                                        tm_t.tm_mon + 1, tm_t.tm_mday, tm_t.tm_hour, tm_t.tm_min, tm_t.tm_sec, (unsigned)ts.millis);
+    }
+    bench_Report("iso8601", console, bench_Seconds() - start);
+}
+
+int main(void)
+{
+    bench_Unsigned();
+    bench_Iso8601();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+"""Report flash and RAM use from an XC8 map file and check it against a budget.
+
+Flash comes from the map's "Module Function Class Link Load Size" listing,
+so it is exact per function and per module. RAM comes from the data psect
+lengths in the TOTAL section; per symbol RAM is estimated from the distance
+to the next symbol in the same psect, which is how the top RAM consumers
+are ranked.
+
+Exit status is 1 when a total or a module exceeds its budget by more than
+the allowed slack, so the MPLAB X .build-post step can flag regressions.
+Budget modules are project relative paths and match the map entry that
+ends with them. A module missing from the map (for example one compiled
+out by a build switch) is listed; when none of them is found the names do
+not fit the map and the check fails rather than pass on nothing.
+"""
+
+import argparse
+import json
+import re
+import sys
+
+DATA_SPACE = 1
+FUNCTION_LINE = re.compile(r"^\s+(\S+)\s+(CODE|STRCODE|CONST|ENTRY|STRING)\s+([0-9A-Fa-f]+)\s+([0-9A-Fa-f]+)\s+(\d+)\s*$")
+MODULE_SIZE = re.compile(r"^\s*(\S.*?)\s+estimated size:\s+(\d+)")
+MODULE_LINE = re.compile(r"^\s*(\S.*\.(?:c|s|as|S))\s*$")        # Library paths may contain spaces
+CLASS_LINE = re.compile(r"^\s+CLASS\s+(\S+)")
+PSECT_LINE = re.compile(r"^\s+(\S+)\s+([0-9A-Fa-f]+)\s+([0-9A-Fa-f]+)\s+([0-9A-Fa-f]+)\s+(\d+)\s*$")
+NOT_IMAGE = ("ABS", "CONFIG", "IDLOC", "EEDATA")                          # Classes outside the code and RAM budgets
+SYMBOL_ENTRY = re.compile(r"(\S+)\s+(\S+)\s+([0-9A-Fa-f]{4})\b")         # Two entries per line
+
+
+def parse(lines):
+    """Returns functions, modules, psects and data symbols found in the map."""
+    functions = {}                      # name -> (module, words)
+    modules = {}                        # module -> words
+    psects = {}                         # name -> (class, link, length, space)
+    symbols = []                        # (name, psect, address)
+    section = None
+    module = None
+    klass = None
+
+    for line in lines:
+        if re.search(r"\bModule\s+Function\s+Class\s+Link\s+Load\s+Size\b", line):
+            section = "functions"
+            continue
+        if re.match(r"^TOTAL\s+Name\s+Link\s+Load\s+Length", line):
+            section = "totals"
+            continue
+        if re.search(r"^\s+Symbol Table\s*$", line):
+            section = "symbols"
+            continue
+        if re.match(r"^\s*(UNUSED ADDRESS RANGES|SEGMENTS|GROUP)", line):
+            section = None
+            continue
+
+        if section == "functions":
+            match = MODULE_SIZE.match(line)
+            if match:
+                modules[match.group(1)] = int(match.group(2))
+                continue
+            match = MODULE_LINE.match(line)
+            if match:
+                module = match.group(1)
+                continue
+            match = FUNCTION_LINE.match(line)
+            if match and module:
+                functions[match.group(1)] = (module, int(match.group(5)))
+        elif section == "totals":
+            match = CLASS_LINE.match(line)
+            if match:
+                klass = match.group(1)
+                continue
+            match = PSECT_LINE.match(line)
+            if match and klass:
+                psects[match.group(1)] = (klass, int(match.group(2), 16), int(match.group(4), 16), int(match.group(5)))
+        elif section == "symbols":
+            for name, psect, address in SYMBOL_ENTRY.findall(line):
+                symbols.append((name, psect, int(address, 16)))
+
+    for name, (owner, words) in functions.items():
+        if owner not in modules:
+            modules[owner] = 0
+    for owner in list(modules):
+        if modules[owner] == 0:
+            modules[owner] = sum(w for m, w in functions.values() if m == owner)
+    return functions, modules, psects, symbols
+
+
+def module_words(modules, name):
+    """Flash of the map module whose path ends with the budget name, None when absent."""
+    for module, words in modules.items():
+        path = module.replace("\\", "/")
+        if path == name or path.endswith("/" + name):
+            return words
+    return None
+
+
+def ram_symbols(psects, symbols):
+    """Sizes of data symbols taken as the gap to the next symbol or the end of the psect."""
+    sizes = {}
+    by_psect = {}
+    for name, psect, address in symbols:
+        if psect in psects and psects[psect][3] == DATA_SPACE and not name.startswith("__"):
+            by_psect.setdefault(psect, []).append((address, name))
+    for psect, entries in by_psect.items():
+        entries.sort()
+        end = psects[psect][1] + psects[psect][2]
+        for index, (address, name) in enumerate(entries):
+            following = entries[index + 1][0] if index + 1 < len(entries) else end
+            if following > address:
+                sizes[name] = following - address
+    return sizes
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("map")
+    parser.add_argument("--budget", help="JSON budget to check against")
+    parser.add_argument("--update", action="store_true", help="write the measured figures into the budget")
+    parser.add_argument("--top", type=int, default=10, help="number of top consumers to list")
+    args = parser.parse_args()
+
+    with open(args.map, encoding="latin-1") as handle:
+        functions, modules, psects, symbols = parse(handle)
+
+    flash = sum(length for klass, link, length, space in psects.values() if space != DATA_SPACE and klass not in NOT_IMAGE)
+    ram = sum(length for klass, link, length, space in psects.values()
+              if space == DATA_SPACE and klass not in NOT_IMAGE and not klass.startswith("SFR"))
+    sizes = ram_symbols(psects, symbols)
+
+    print("Footprint of %s" % args.map)
+    print("  flash %6d words" % flash)
+    print("  ram   %6d bytes" % ram)
+    print("\n  flash by module")
+    for module, words in sorted(modules.items(), key=lambda item: -item[1]):
+        print("    %6d  %s" % (words, module))
+    print("\n  top %d functions (words)" % args.top)
+    for name, (module, words) in sorted(functions.items(), key=lambda item: -item[1][1])[:args.top]:
+        print("    %6d  %-32s %s" % (words, name, module))
+    print("\n  top %d RAM symbols (bytes, estimated)" % args.top)
+    for name, size in sorted(sizes.items(), key=lambda item: -item[1])[:args.top]:
+        print("    %6d  %s" % (size, name))
+
+    if not args.budget:
+        return 0
+
+    try:
+        with open(args.budget) as handle:
+            budget = json.load(handle)
+    except FileNotFoundError:
+        budget = {}
+
+    if args.update:
+        budget.update({"flash_words": flash, "ram_bytes": ram, "modules": modules})
+        budget.setdefault("slack_percent", 2)
+        with open(args.budget, "w") as handle:
+            json.dump(budget, handle, indent=4, sort_keys=True)
+            handle.write("\n")
+        print("\n  budget %s updated" % args.budget)
+        return 0
+
+    slack = 1 + budget.get("slack_percent", 0) / 100.0
+    failures = []
+    for key, value in (("flash_words", flash), ("ram_bytes", ram)):
+        if key in budget and value > budget[key] * slack:
+            failures.append("%s %d over budget %d" % (key, value, budget[key]))
+    missing = []
+    for module, limit in sorted(budget.get("modules", {}).items()):
+        words = module_words(modules, module)
+        if words is None:
+            missing.append(module)
+        elif words > limit * slack:
+            failures.append("%s %d words over budget %d" % (module, words, limit))
+    if missing and len(missing) == len(budget["modules"]):
+        failures.append("no budget module found in the map, check the module names")
+
+    print()
+    for module in missing:
+        print("  not in map: " + module)
+    for failure in failures:
+        print("  FOOTPRINT REGRESSION: " + failure)
+    if not failures:
+        print("  within budget %s" % args.budget)
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
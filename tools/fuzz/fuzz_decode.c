@@ -0,0 +1,363 @@
+/*
+ * File:   fuzz_decode.c
+ *
+ * libFuzzer harness for the code that turns untrusted bytes into times:
+ * console input (epoch parser, text and binary batches, time zone entry),
+ * RTCC register contents (regmap decode) and the time zone record kept in
+ * the RTCC SRAM. The first input byte picks the target, the rest is the
+ * data. Every target checks its invariants and aborts on a violation;
+ * out of range indexing is left to AddressSanitizer.
+ *
+ * Build with FUZZ_STANDALONE to run without libFuzzer: each argument is a
+ * corpus file, and with no argument a fixed number of random inputs is
+ * generated.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "host.h"
+#include "command.h"
+#include "datetime.h"
+#include "regmap.h"
+#include "rtcc_map.h"
+#include "systime.h"
+#include "timezone.h"
+
+#define TARGET_EPOCH                (0)                                       //  command_EpochFeed()
+#define TARGET_TEXT_BATCH           (1)                                       //  command_TextBatch()
+#define TARGET_BINARY_BATCH         (2)                                       //  command_BinaryBatch()
+#define TARGET_TIME_ZONE            (3)                                       //  command_TimeZone()
+#define TARGET_FIELDS               (4)                                       //  regmap_Unpack() and regmap_Pack()
+#define TARGET_READ_FIELDS          (5)                                       //  regmap_ReadFields() over the bus
+#define TARGET_DATETIME             (6)                                       //  datetime_xxx round trips
+#define TARGET_SRAM_RECORD          (7)                                       //  timezone_Initialize() on a stored record
+#define TARGETS                     (8)
+
+#define IMAGE_REGS                  (REGMAP_SPAN_MAX)
+#define TZ_CHECK_SEED               (0x5A)                                    //  CONFIG_CHECK_SEED in timezone.c
+#define STANDALONE_RUNS             (200000UL)
+#define STALL_LIMIT_MS              (1000UL)                                  //  Far above the regmap bus timeout
+
+#define CHECK(cond)                 do { if (!(cond)) fuzz_Fail(#cond, __LINE__); } while (0)
+
+static void fuzz_Fail(const char *what, int line)
+{
+    fprintf(stderr, "fuzz_decode.c:%d: invariant failed: %s\n", line, what);
+    abort();
+}
+
+static uint32_t fuzz_Le32(const uint8_t *data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+// Any 32-bit value folded into the range the clock can hold
+static uint32_t fuzz_Epoch(const uint8_t *data)
+{
+    return DATETIME_EPOCH_MIN + fuzz_Le32(data) % (DATETIME_EPOCH_MAX - DATETIME_EPOCH_MIN + 1);
+}
+
+static void fuzz_CheckTm(const struct tm *tm_t)
+{
+    CHECK(tm_t->tm_sec >= 0 && tm_t->tm_sec <= 59);
+    CHECK(tm_t->tm_min >= 0 && tm_t->tm_min <= 59);
+    CHECK(tm_t->tm_hour >= 0 && tm_t->tm_hour <= 23);
+    CHECK(tm_t->tm_mday >= 1 && tm_t->tm_mday <= 31);
+    CHECK(tm_t->tm_mon >= 0 && tm_t->tm_mon <= 11);
+    CHECK(tm_t->tm_wday >= 0 && tm_t->tm_wday <= 6);
+    CHECK(tm_t->tm_yday >= 0 && tm_t->tm_yday <= 365);
+}
+
+static void fuzz_CheckConfig(const TzConfig_t *config)
+{
+    CHECK(config->offset >= -720 && config->offset <= 840);
+    CHECK(config->dstDelta >= 0 && config->dstDelta <= 120);
+    if (config->dstDelta != 0)
+    {
+        CHECK(config->start.month >= 1 && config->start.month <= 12 && config->end.month >= 1 && config->end.month <= 12);
+        CHECK(config->start.week >= 1 && config->start.week <= TIMEZONE_RULE_LAST);
+        CHECK(config->end.week >= 1 && config->end.week <= TIMEZONE_RULE_LAST);
+        CHECK(config->start.wday <= 6 && config->end.wday <= 6);
+        CHECK(config->start.minute < 1440 && config->end.minute < 1440);
+    }
+}
+
+// Local time of a few instants under the active zone
+static void fuzz_Render(const uint8_t *data, size_t size)
+{
+    struct tm tm_t;
+    uint8_t word[4] = {0};
+
+    memcpy(word, data, size < sizeof (word) ? size : sizeof (word));
+    timezone_ToLocal(fuzz_Epoch(word), &tm_t);
+    fuzz_CheckTm(&tm_t);
+    timezone_ToLocal(DATETIME_EPOCH_MIN, &tm_t);
+    fuzz_CheckTm(&tm_t);
+    timezone_ToLocal(DATETIME_EPOCH_MAX, &tm_t);
+    fuzz_CheckTm(&tm_t);
+}
+
+// Reference decimal value of the digits, saturated above 32 bits
+static void fuzz_Epoch_Target(const uint8_t *data, size_t size)
+{
+    EpochParser_t parser;
+    uint64_t reference = 0;
+    bool clean = true;
+    uint8_t status = COMMAND_EPOCH_BUSY;
+    size_t index;
+
+    command_EpochReset(&parser);
+    for (index = 0; index < size && status == COMMAND_EPOCH_BUSY; index++)
+    {
+        uint8_t rxByte = data[index];
+
+        status = command_EpochFeed(&parser, rxByte);
+        if (rxByte >= '0' && rxByte <= '9')
+        {
+            reference = (reference > UINT32_MAX) ? reference : reference * 10 + (rxByte - '0');
+        }
+        else if (rxByte != '\r' && rxByte != '\n')
+        {
+            clean = false;
+        }
+    }
+    if (status == COMMAND_EPOCH_DONE)
+    {
+        CHECK(clean && reference == parser.value);
+        CHECK(DATETIME_EPOCH_VALID(parser.value));
+    }
+    if (status == COMMAND_EPOCH_INVALID)
+    {
+        CHECK(!clean || !DATETIME_EPOCH_VALID(reference));
+    }
+}
+
+// Whatever reaches the driver must be a complete, in range batch
+static void fuzz_CheckBatch(void)
+{
+    if (!hostBatchSeen)
+    {
+        return;
+    }
+    CHECK(hostBatch.ops != 0);
+    CHECK((hostBatch.ops & ~(RTCC_BATCH_SET_TIME | RTCC_BATCH_SET_ALARM0 | RTCC_BATCH_SET_ALARM1 | RTCC_BATCH_ENABLE | RTCC_BATCH_READ_BACK)) == 0);
+    CHECK(!(hostBatch.ops & RTCC_BATCH_SET_TIME) || DATETIME_EPOCH_VALID((uint32_t)hostBatch.time));
+    CHECK(!(hostBatch.ops & RTCC_BATCH_SET_ALARM0) || DATETIME_EPOCH_VALID((uint32_t)hostBatch.alarm0));
+    CHECK(!(hostBatch.ops & RTCC_BATCH_SET_ALARM1) || DATETIME_EPOCH_VALID((uint32_t)hostBatch.alarm1));
+}
+
+// Each field alone: the decoded value is in range and packs back to the same bits
+static void fuzz_Fields_Target(const uint8_t *data, size_t size)
+{
+    const RegMapDevice_t *dev = &MCP79410_Device;
+    uint8_t image[IMAGE_REGS] = {0};
+    uint8_t packed[IMAGE_REGS];
+    uint8_t id;
+    uint8_t value;
+
+    memcpy(image, data, size < sizeof (image) ? size : sizeof (image));
+    for (id = 0; id < dev->fieldCount; id++)
+    {
+        const RegField_t *field = &dev->fields[id];
+        uint8_t raw = (uint8_t)((image[field->reg] >> field->shift) & ((1U << field->width) - 1U));
+
+        if (!regmap_Unpack(dev, &id, &value, 1, 0, image, IMAGE_REGS))
+        {
+            CHECK(field->bcd && ((raw & 0x0F) > 9 || (raw >> 4) > 9));
+            continue;
+        }
+        if (field->bcd)
+        {
+            CHECK((raw & 0x0F) <= 9 && (raw >> 4) <= 9);
+            CHECK(value == (raw >> 4) * 10 + (raw & 0x0F));
+        }
+        else
+        {
+            CHECK(value == raw);
+        }
+        memcpy(packed, image, sizeof (packed));
+        CHECK(regmap_Pack(dev, &id, &value, 1, 0, packed, IMAGE_REGS));
+        CHECK(memcmp(packed, image, sizeof (packed)) == 0);
+    }
+    id = 0;
+    CHECK(!regmap_Unpack(dev, &id, &value, 1, 1, image, IMAGE_REGS));       // SECONDS lies before the image
+    id = FIELD_COUNT;
+    CHECK(!regmap_Unpack(dev, &id, &value, 1, 0, image, IMAGE_REGS));       // Unknown field
+}
+
+// Seconds..Year as the chip would return them: a time that decodes is a calendar time or is refused.
+// Bit 7 of the first byte stalls the bus instead, which has to fail within the bus timeout.
+static void fuzz_ReadFields_Target(const uint8_t *data, size_t size)
+{
+    static const uint8_t timeFields[] = {FIELD_SECONDS, FIELD_MINUTES, FIELD_HOURS, FIELD_WEEKDAY, FIELD_DATE, FIELD_MONTH, FIELD_YEAR};
+    DateTime_t dt;
+    struct tm tm_t;
+    uint32_t start = systime_Millis();
+    bool retStatus;
+
+    if (size != 0 && (data[0] & 0x80))
+    {
+        host_Stall(true);
+        retStatus = regmap_ReadFields(&MCP79410_Device, timeFields, (uint8_t *)&dt, sizeof (timeFields));
+        CHECK(!retStatus);
+        CHECK(systime_Millis() - start < STALL_LIMIT_MS);
+        return;
+    }
+    host_Feed(data, size);
+    if (regmap_ReadFields(&MCP79410_Device, timeFields, (uint8_t *)&dt, sizeof (timeFields)) && datetime_IsValid(&dt))
+    {
+        CHECK(DATETIME_EPOCH_VALID(datetime_ToEpoch(&dt)));
+        datetime_ToTm(&dt, &tm_t);
+        fuzz_CheckTm(&tm_t);
+    }
+}
+
+static void fuzz_DateTime_Target(const uint8_t *data, size_t size)
+{
+    DateTime_t dt;
+    DateTime_t back;
+    uint32_t epoch;
+
+    if (size < sizeof (dt) + 4)
+    {
+        return;
+    }
+    memcpy(&dt, data, sizeof (dt));                                          // Arbitrary fields
+    if (datetime_IsValid(&dt))
+    {
+        epoch = datetime_ToEpoch(&dt);
+        CHECK(DATETIME_EPOCH_VALID(epoch));
+        datetime_FromEpoch(epoch, &back);
+        CHECK(back.sec == dt.sec && back.min == dt.min && back.hour == dt.hour);
+        CHECK(back.mday == dt.mday && back.month == dt.month && back.year == dt.year);
+    }
+    epoch = fuzz_Epoch(data + sizeof (dt));                                  // Any instant the clock can hold
+    datetime_FromEpoch(epoch, &back);
+    CHECK(datetime_IsValid(&back));
+    CHECK(datetime_ToEpoch(&back) == epoch);
+    CHECK(back.wday == (uint8_t)((epoch / 86400UL + 4) % 7 + 1));
+}
+
+// A record with a matching check byte, so every corruption reaches the range checks
+static void fuzz_SramRecord_Target(const uint8_t *data, size_t size)
+{
+    uint8_t *record = &hostSram[SRAM_TIMEZONE];
+    uint8_t check = TZ_CHECK_SEED;
+    size_t index;
+
+    memset(hostSram, 0xFF, sizeof (hostSram));
+    memcpy(record, data, size < sizeof (TzConfig_t) ? size : sizeof (TzConfig_t));
+    for (index = 0; index < sizeof (TzConfig_t); index++)
+    {
+        check ^= record[index];
+    }
+    record[sizeof (TzConfig_t)] = check;
+    timezone_Initialize();
+    fuzz_CheckConfig(timezone_Get());
+    if (size > sizeof (TzConfig_t))
+    {
+        fuzz_Render(data + sizeof (TzConfig_t), size - sizeof (TzConfig_t));
+    }
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    uint8_t target;
+
+    if (size == 0)
+    {
+        return 0;
+    }
+    target = data[0] % TARGETS;
+    data++;
+    size--;
+    systime_Use(&systime_VirtualClock);
+    host_Stall(false);
+    memset(hostSram, 0xFF, sizeof (hostSram));                               // Blank SRAM, default zone
+    timezone_Initialize();
+    hostBatchSeen = false;
+    host_Feed(NULL, 0);
+
+    switch (target)
+    {
+        case TARGET_EPOCH:
+            fuzz_Epoch_Target(data, size);
+            break;
+        case TARGET_TEXT_BATCH:
+            host_Feed(data, size);
+            command_TextBatch();
+            fuzz_CheckBatch();
+            break;
+        case TARGET_BINARY_BATCH:
+            host_Feed(data, size);
+            command_BinaryBatch();
+            fuzz_CheckBatch();
+            break;
+        case TARGET_TIME_ZONE:
+            host_Feed(data, size);
+            command_TimeZone();
+            fuzz_CheckConfig(timezone_Get());
+            fuzz_Render(data, size);
+            break;
+        case TARGET_FIELDS:
+            fuzz_Fields_Target(data, size);
+            break;
+        case TARGET_READ_FIELDS:
+            fuzz_ReadFields_Target(data, size);
+            break;
+        case TARGET_DATETIME:
+            fuzz_DateTime_Target(data, size);
+            break;
+        default:
+            fuzz_SramRecord_Target(data, size);
+            break;
+    }
+    return 0;
+}
+
+#ifdef FUZZ_STANDALONE
+#define STANDALONE_MAX_INPUT        (256)
+
+int main(int argc, char **argv)
+{
+    uint8_t input[STANDALONE_MAX_INPUT];
+    unsigned long run;
+    size_t size;
+    size_t index;
+    int arg;
+
+    for (arg = 1; arg < argc; arg++)
+    {
+        FILE *file = fopen(argv[arg], "rb");
+
+        if (file == NULL)
+        {
+            perror(argv[arg]);
+            return 1;
+        }
+        size = fread(input, 1, sizeof (input), file);
+        fclose(file);
+        LLVMFuzzerTestOneInput(input, size);
+    }
+    if (argc > 1)
+    {
+        return 0;
+    }
+    srand(1);
+    for (run = 0; run < STANDALONE_RUNS; run++)
+    {
+        size = (size_t)rand() % sizeof (input);
+        for (index = 0; index < size; index++)
+        {
+            // Mostly digits, terminators and token letters so the parsers get past the first byte
+            int pick = rand() % 4;
+            input[index] = (uint8_t)(pick == 0 ? '0' + rand() % 10 : pick == 1 ? "\r\n TABERZ-;"[rand() % 11] : rand());
+        }
+        LLVMFuzzerTestOneInput(input, size);
+    }
+    printf("%lu inputs, no invariant failed\n", run);
+    return 0;
+}
+#endif
@@ -0,0 +1,185 @@
+/*
+ * File:   host.c
+ *
+ * Host replacements for the drivers the decode modules call. The UART and
+ * the I2C bus hand out bytes from the current fuzz input, the SRAM read
+ * returns a record taken from it, and everything that would print does
+ * nothing. Time is the systime virtual clock; a stalled bus advances it
+ * by a millisecond per I2C1_Tasks() call, as the real bus would age.
+ */
+
+#include <string.h>
+#include "host.h"
+#include "console.h"
+#include "supervisor.h"
+#include "systime.h"
+#include "timestamp.h"
+#include "mcc_generated_files/i2c_host/mssp1.h"
+#include "mcc_generated_files/uart/eusart1.h"
+
+static const uint8_t *hostData;
+static size_t hostSize;
+static bool hostStall;
+static bool hostTail;
+
+uint8_t hostSram[HOST_SRAM_SIZE];
+RtccBatch_t hostBatch;
+bool hostBatchSeen;
+
+void host_Feed(const uint8_t *data, size_t size)
+{
+    hostData = data;
+    hostSize = size;
+    hostTail = false;
+}
+
+void host_Stall(bool stall)
+{
+    hostStall = stall;
+}
+
+size_t host_Remaining(void)
+{
+    return hostSize;
+}
+
+// Next input byte. Past the end CR and a stray letter alternate, so a reader
+// that skips leading terminators still gets an entry that ends it.
+uint8_t host_Byte(void)
+{
+    if (hostSize == 0)
+    {
+        hostTail = !hostTail;
+        return hostTail ? '\r' : 'x';
+    }
+    hostSize--;
+    return *hostData++;
+}
+
+bool EUSART1_IsRxReady(void)
+{
+    return true;
+}
+
+uint8_t EUSART1_Read(void)
+{
+    return host_Byte();
+}
+
+void EUSART1_WriteBuffer(const uint8_t *txData, uint8_t length)
+{
+    (void)txData;
+    (void)length;
+}
+
+bool I2C1_Write(uint16_t address, uint8_t *data, size_t dataLength)
+{
+    (void)address;
+    (void)data;
+    (void)dataLength;
+    return true;
+}
+
+bool I2C1_WriteRead(uint16_t address, uint8_t *writeData, size_t writeLength, uint8_t *readData, size_t readLength)
+{
+    (void)address;
+    (void)writeData;
+    (void)writeLength;
+    while (readLength--)
+    {
+        *readData++ = host_Byte();
+    }
+    return true;
+}
+
+i2c_host_error_t I2C1_ErrorGet(void)
+{
+    return I2C_ERROR_NONE;
+}
+
+bool I2C1_IsBusy(void)
+{
+    return hostStall;
+}
+
+void I2C1_Tasks(void)
+{
+    systime_Advance(1);
+}
+
+void I2C1_Initialize(void)
+{
+}
+
+void I2C1_Deinitialize(void)
+{
+    hostStall = false;                                                       // The reset frees the bus
+}
+
+uint16_t TMR1_Read(void)
+{
+    return 0;                                                                // Only the target clock reads Timer1
+}
+
+void console_PutChar(char character)
+{
+    (void)character;
+}
+
+void console_PutString(const char *text)
+{
+    (void)text;
+}
+
+void console_PutUnsigned(uint32_t value, uint8_t width)
+{
+    (void)value;
+    (void)width;
+}
+
+void console_PutSigned(int32_t value)
+{
+    (void)value;
+}
+
+void console_PutHex(uint8_t value)
+{
+    (void)value;
+}
+
+void supervisor_Wait(void)
+{
+}
+
+void timestamp_Sync(time_t now)
+{
+    (void)now;
+}
+
+bool rtc6_ExecuteBatch(RtccBatch_t *batch)
+{
+    hostBatch = *batch;
+    hostBatchSeen = true;
+    batch->readBack = DATETIME_EPOCH_MIN;
+    return true;
+}
+
+bool rtc6_ReadSram(uint8_t offset, uint8_t *data, uint8_t length)
+{
+    if ((size_t)offset + length > HOST_SRAM_SIZE)
+    {
+        return false;
+    }
+    memcpy(data, &hostSram[offset], length);
+    return true;
+}
+
+bool rtc6_WriteSram(uint8_t offset, const uint8_t *data, uint8_t length)
+{
+    if ((size_t)offset + length > HOST_SRAM_SIZE)
+    {
+        return false;
+    }
+    memcpy(&hostSram[offset], data, length);
+    return true;
+}
@@ -0,0 +1,25 @@
+/*
+ * File:   host.h
+ *
+ * Host side of the decode fuzz harness, see host.c
+ */
+#ifndef HOST_H
+#define HOST_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "application.h"
+
+#define HOST_SRAM_SIZE              (RTCC_SRAM_SIZE)
+
+extern uint8_t hostSram[HOST_SRAM_SIZE];
+extern RtccBatch_t hostBatch;                                                // Last batch handed to rtc6_ExecuteBatch()
+extern bool hostBatchSeen;
+
+void host_Feed(const uint8_t *data, size_t size);
+void host_Stall(bool stall);                                                 // Bus stays busy until I2C1_Deinitialize()
+size_t host_Remaining(void);
+uint8_t host_Byte(void);
+
+#endif
@@ -0,0 +1 @@
+/* XC8 ships this header with its C library, glibc does not. Empty on the host. */
@@ -0,0 +1,24 @@
+/*
+ * Host stand-in for the XC8 device header, just enough for the decode
+ * modules and the alarm simulation to compile with gcc or clang. The only
+ * register is the IOC enable the application saves and restores, which
+ * the simulation defines.
+ */
+#ifndef FUZZ_XC_H
+#define FUZZ_XC_H
+
+#include <stdint.h>
+
+#define __interrupt(...)
+#define __persistent
+#define __at(x)
+#define __section(x)
+#define __bit _Bool
+#define CLRWDT() ((void)0)
+#define NOP() ((void)0)
+#define __delay_ms(x) ((void)(x))
+
+typedef struct {unsigned INTE:1; unsigned IOCIE:1;} __PIE0bits_t;
+extern volatile __PIE0bits_t PIE0bits;
+
+#endif
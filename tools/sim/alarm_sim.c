@@ -0,0 +1,220 @@
+/*
+ * File:   alarm_sim.c
+ *
+ * Runs the rtc6 driver against the MCP79410 model for several days of
+ * virtual time, one second per step, so the alarm path is checked across
+ * midnight, a month end and a leap day in well under a second of host
+ * time. The RTCC starts cold and in 12 hour mode, as other firmware may
+ * leave it; the firmware brings it up in 24 hours, sets the clock,
+ * arms a daily repeating alarm and a one-shot alarm, and services the
+ * flags after every second as the main loop would after an MFP edge.
+ * Everything outside the driver and the modules it calls is a stub.
+ */
+
+#define _DEFAULT_SOURCE                                                      // timegm()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "rtcc_model.h"
+#include "application.h"
+#include "command.h"
+#include "console.h"
+#include "datetime.h"
+#include "latency.h"
+#include "pinevent.h"
+#include "regmap.h"
+#include "supervisor.h"
+#include "systime.h"
+#include "mcc_generated_files/uart/eusart1.h"
+
+#define SIM_DAYS                    (4)
+#define SIM_POLL_MS                 (10UL)                                    //  Main loop pass while the crystal starts
+#define SECONDS_PER_DAY             (86400L)
+#define SECONDS_PER_HOUR            (3600L)
+
+#define CHECK(cond)                 do { if (!(cond)) sim_Fail(#cond, __LINE__); } while (0)
+
+volatile __PIE0bits_t PIE0bits;
+
+static void sim_Fail(const char *what, int line)
+{
+    fprintf(stderr, "alarm_sim.c:%d: check failed: %s (RTCC at %ld)\n", line, what, (long)model_Time());
+    exit(EXIT_FAILURE);
+}
+
+static time_t sim_Utc(int year, int month, int day, int hour, int min, int sec)
+{
+    struct tm tm_t;
+
+    memset(&tm_t, 0, sizeof (tm_t));
+    tm_t.tm_year = year - 1900;
+    tm_t.tm_mon = month - 1;
+    tm_t.tm_mday = day;
+    tm_t.tm_hour = hour;
+    tm_t.tm_min = min;
+    tm_t.tm_sec = sec;
+    return timegm(&tm_t);
+}
+
+// Cold chip: rtc6_Initialize() starts the crystal, the main loop polls OSCRUN
+static void sim_Start(void)
+{
+    uint32_t started = systime_Millis();
+    uint8_t status;
+
+    CHECK(rtc6_Initialize() == RTCC_INIT_STARTING);
+    do
+    {
+        systime_Advance(SIM_POLL_MS);
+        status = rtc6_PollStart();
+    } while (status == RTCC_INIT_STARTING);
+    CHECK(status == RTCC_INIT_READY);
+    CHECK(systime_Millis() - started >= MODEL_OSC_START_MS);
+    CHECK((rtc6_CheckHealth() & RTCC_HEALTH_WARM) == RTCC_HEALTH_WARM);
+}
+
+// Stopped chip holding 11:59:30 PM, 2024-02-28 in 12 hour mode
+static void sim_TwelveHour(void)
+{
+    uint8_t clock[] = {0x00, 0x30, 0x59, 0x40 | 0x20 | 0x11, 0x03, 0x28, 0x02, 0x24};
+
+    I2C1_Write(0x6F, clock, sizeof (clock));
+}
+
+int main(void)
+{
+    time_t start = sim_Utc(2024, 2, 28, 22, 0, 0);                          // Leap day and a month end within the run
+    time_t midnight = sim_Utc(2024, 2, 29, 0, 0, 0);
+    time_t oneShot = sim_Utc(2024, 3, 1, 12, 34, 56);
+    time_t now;
+    RtccAlarm_t image;
+    DateTime_t dt;
+    long second;
+    uint8_t fired;
+    int daily = 0;
+    int single = 0;
+
+    systime_Use(&systime_VirtualClock);
+    model_PowerUp();
+    sim_TwelveHour();
+    sim_Start();
+    CHECK((model_Register(0x02) & 0x7F) == 0x23);                           // Same hour, now in 24 hours
+    CHECK(rtc6_GetTime() == sim_Utc(2024, 2, 28, 23, 59, 30));
+
+    CHECK(rtc6_SetTime(start));
+    CHECK(model_Time() == start);
+    CHECK(rtc6_SetRepeatingAlarm(1, midnight, RTCC_ALARM_MATCH_HOURS));
+    datetime_FromEpoch((uint32_t)oneShot, &dt);
+    CHECK(rtc6_PrepareAlarm(&dt, RTCC_ALARM_ACTIVE_HIGH, RTCC_ALARM_MATCH_FULL, &image));
+    CHECK(rtc6_SetAlarm0(&image) && rtc6_EnableAlarm(0, true));
+
+    for (second = 1; second <= SIM_DAYS * SECONDS_PER_DAY; second++)
+    {
+        systime_Advance(1000);
+        now = model_Time();
+        CHECK(now == start + second);
+        fired = rtc6_ServiceAlarms();
+        if (fired & RTCC_ALARM1)
+        {
+            CHECK(now == midnight + daily * SECONDS_PER_DAY);                // Once a day, on the hour it was set for
+            daily++;
+        }
+        if (fired & RTCC_ALARM0)
+        {
+            CHECK(now == oneShot);
+            single++;
+        }
+        if (second % SECONDS_PER_HOUR == 0)
+        {
+            CHECK(rtc6_GetTime() == now);                                    // Firmware calendar against the C library
+        }
+    }
+    CHECK(daily == SIM_DAYS);
+    CHECK(single == 1);
+    CHECK((model_Register(0x0D) & 0x08) == 0);                              // Both flags were cleared
+    CHECK((model_Register(0x14) & 0x08) == 0);
+
+    printf("%d days simulated: %d daily alarms, %d one-shot alarm, clock matches the model\n", SIM_DAYS, daily, single);
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Stubs for the modules application.c calls outside the alarm path
+ */
+bool EUSART1_IsRxReady(void)
+{
+    return false;
+}
+
+uint8_t EUSART1_Read(void)
+{
+    return 0;
+}
+
+uint16_t TMR1_Read(void)
+{
+    return (uint16_t)(systime_Millis() * 31);                               // About TMR1_NOMINAL_FREQUENCY
+}
+
+bool command_ReadEpoch(time_t *epoch)
+{
+    *epoch = 0;
+    return false;
+}
+
+void command_TextBatch(void)
+{
+}
+
+void command_BinaryBatch(void)
+{
+}
+
+void command_TimeZone(void)
+{
+}
+
+void console_PutChar(char character)
+{
+}
+
+void console_PutString(const char *text)
+{
+}
+
+void console_PutUnsigned(uint32_t value, uint8_t width)
+{
+}
+
+void console_PutDateTime(const struct tm *tm_t)
+{
+}
+
+void console_PutIso8601(const Timestamp_t *ts)
+{
+}
+
+void latency_Edge(uint16_t edge)
+{
+}
+
+bool latency_Take(LatencyEdge_t *sample)
+{
+    memset(sample, 0, sizeof (*sample));
+    return false;
+}
+
+uint16_t pinevent_Glitches(void)
+{
+    return 0;
+}
+
+void supervisor_Checkpoint(uint8_t check)
+{
+}
+
+void supervisor_Wait(void)
+{
+}
@@ -0,0 +1,264 @@
+/*
+ * File:   rtcc_model.c
+ *
+ * MCP79410 register model for the host simulation. The chip follows the
+ * systime virtual clock: before every transaction it catches up with the
+ * time that has passed, counting seconds while ST is set and OSCRUN is up,
+ * and raising ALMxIF when an enabled alarm starts to match. The calendar
+ * step uses the C library, not the firmware, so the two are checked
+ * against each other. The I2C1 driver calls complete at once.
+ */
+
+#define _DEFAULT_SOURCE                                                      // timegm()
+
+#include <string.h>
+#include <time.h>
+#include "rtcc_model.h"
+#include "systime.h"
+#include "mcc_generated_files/i2c_host/mssp1.h"
+
+#define MODEL_REGS                  (0x60)                                    //  Timekeeping, alarms, stamps and SRAM
+#define REG_SECONDS                 (0x00)
+#define REG_WEEKDAY                 (0x03)
+#define REG_CONTROL                 (0x07)
+#define ST_BIT                      (0x80)
+#define HOUR_12_BIT                 (0x40)
+#define OSCRUN_BIT                  (0x20)
+#define LPYR_BIT                    (0x20)
+#define ALMIF_BIT                   (0x08)
+#define ALMEN_BIT(alarm)            (0x10 << (alarm))
+#define ALARM_BANK(alarm)           ((alarm) ? 0x11 : 0x0A)
+
+static uint8_t modelRegs[MODEL_REGS];
+static uint32_t modelSeen;                                                   // systime_Millis() already applied
+static uint32_t modelPhase;                                                  // ms into the current second
+static uint32_t modelStartAt;                                                // OSCRUN rises at this time
+static bool modelStarting;
+static bool modelCold;                                                       // The crystal has not run since power up
+
+static uint8_t model_Bin(uint8_t bcd)
+{
+    return (uint8_t)((bcd >> 4) * 10 + (bcd & 0x0F));
+}
+
+static uint8_t model_Bcd(uint8_t value)
+{
+    return (uint8_t)(((value / 10) << 4) | (value % 10));
+}
+
+static bool model_Decode(struct tm *tm_t)
+{
+    memset(tm_t, 0, sizeof (*tm_t));
+    if (modelRegs[0x02] & HOUR_12_BIT)
+    {
+        return false;                                                        // The firmware always selects 24 hours
+    }
+    tm_t->tm_sec = model_Bin(modelRegs[0x00] & 0x7F);
+    tm_t->tm_min = model_Bin(modelRegs[0x01] & 0x7F);
+    tm_t->tm_hour = model_Bin(modelRegs[0x02] & 0x3F);
+    tm_t->tm_mday = model_Bin(modelRegs[0x04] & 0x3F);
+    tm_t->tm_mon = model_Bin(modelRegs[0x05] & 0x1F) - 1;
+    tm_t->tm_year = model_Bin(modelRegs[0x06]) + 100;
+    return tm_t->tm_mday >= 1 && tm_t->tm_mon >= 0 && tm_t->tm_mon <= 11 && tm_t->tm_sec <= 59
+        && tm_t->tm_min <= 59 && tm_t->tm_hour <= 23;
+}
+
+// Alarm match as selected by ALMxMSK, the weekday register counts 1..7 as the firmware writes it
+static bool model_Match(uint8_t alarm, const struct tm *tm_t, uint8_t weekday)
+{
+    const uint8_t *bank = &modelRegs[ALARM_BANK(alarm)];
+    bool sec = (tm_t->tm_sec == model_Bin(bank[0] & 0x7F));
+    bool min = (tm_t->tm_min == model_Bin(bank[1] & 0x7F));
+    bool hour = (tm_t->tm_hour == model_Bin(bank[2] & 0x3F));
+    bool wday = (weekday == (bank[3] & 0x07));
+    bool mday = (tm_t->tm_mday == model_Bin(bank[4] & 0x3F));
+    bool month = (tm_t->tm_mon + 1 == model_Bin(bank[5] & 0x1F));
+
+    switch ((bank[3] >> 4) & 0x07)
+    {
+        case 0: return sec;
+        case 1: return min;
+        case 2: return hour;
+        case 3: return wday;
+        case 4: return mday;
+        case 7: return sec && min && hour && wday && mday && month;
+        default: return false;
+    }
+}
+
+static void model_Tick(void)
+{
+    struct tm before;
+    struct tm after;
+    time_t next;
+    uint8_t weekday = modelRegs[REG_WEEKDAY] & 0x07;
+    uint8_t nextWeekday = weekday;
+    uint8_t alarm;
+
+    if (!model_Decode(&before))
+    {
+        return;                                                              // Garbage in the registers, the real chip would count it anyway
+    }
+    next = timegm(&before) + 1;
+    gmtime_r(&next, &after);
+    if (after.tm_mday != before.tm_mday)
+    {
+        nextWeekday = (uint8_t)(weekday % 7 + 1);
+    }
+    modelRegs[0x00] = (uint8_t)((modelRegs[0x00] & ST_BIT) | model_Bcd((uint8_t)after.tm_sec));
+    modelRegs[0x01] = model_Bcd((uint8_t)after.tm_min);
+    modelRegs[0x02] = model_Bcd((uint8_t)after.tm_hour);
+    modelRegs[0x03] = (uint8_t)((modelRegs[0x03] & 0xF8) | nextWeekday);
+    modelRegs[0x04] = model_Bcd((uint8_t)after.tm_mday);
+    modelRegs[0x05] = (uint8_t)(((after.tm_year % 4 == 0) ? LPYR_BIT : 0) | model_Bcd((uint8_t)(after.tm_mon + 1)));
+    modelRegs[0x06] = model_Bcd((uint8_t)(after.tm_year - 100));
+    for (alarm = 0; alarm < 2; alarm++)
+    {
+        if ((modelRegs[REG_CONTROL] & ALMEN_BIT(alarm)) && model_Match(alarm, &after, nextWeekday)
+            && !model_Match(alarm, &before, weekday))
+        {
+            modelRegs[ALARM_BANK(alarm) + 3] |= ALMIF_BIT;
+        }
+    }
+}
+
+// Applies the virtual time that passed since the previous transaction
+static void model_CatchUp(void)
+{
+    uint32_t now = systime_Millis();
+    uint32_t step;
+
+    while (modelSeen != now)
+    {
+        step = now - modelSeen;
+        if (modelStarting)
+        {
+            if (modelSeen >= modelStartAt)
+            {
+                modelStarting = false;
+                modelPhase = 0;
+                modelRegs[REG_WEEKDAY] |= OSCRUN_BIT;
+                continue;
+            }
+            if (step > modelStartAt - modelSeen)
+            {
+                step = modelStartAt - modelSeen;
+            }
+        }
+        else if (modelRegs[REG_WEEKDAY] & OSCRUN_BIT)
+        {
+            if (step > 1000 - modelPhase)
+            {
+                step = 1000 - modelPhase;
+            }
+            modelPhase += step;
+            if (modelPhase == 1000)
+            {
+                modelPhase = 0;
+                model_Tick();
+            }
+        }
+        modelSeen += step;
+    }
+}
+
+static void model_Store(uint8_t reg, uint8_t value)
+{
+    if (reg >= MODEL_REGS)
+    {
+        return;
+    }
+    if (reg == REG_SECONDS)
+    {
+        if ((value & ST_BIT) && !(modelRegs[reg] & ST_BIT))
+        {
+            modelStarting = true;                                            // Restarted after a time set, the divider begins again
+            modelStartAt = modelSeen + (modelCold ? MODEL_OSC_START_MS : 0);
+            modelCold = false;
+        }
+        else if (!(value & ST_BIT))
+        {
+            modelStarting = false;
+            modelRegs[REG_WEEKDAY] &= (uint8_t)~OSCRUN_BIT;
+        }
+    }
+    if (reg == REG_WEEKDAY)
+    {
+        value = (uint8_t)((value & ~OSCRUN_BIT) | (modelRegs[reg] & OSCRUN_BIT));  // OSCRUN is read only
+    }
+    modelRegs[reg] = value;
+}
+
+void model_PowerUp(void)
+{
+    memset(modelRegs, 0, sizeof (modelRegs));
+    modelSeen = systime_Millis();
+    modelPhase = 0;
+    modelStarting = false;
+    modelCold = true;
+}
+
+time_t model_Time(void)
+{
+    struct tm tm_t;
+
+    model_CatchUp();
+    return model_Decode(&tm_t) ? timegm(&tm_t) : (time_t)-1;
+}
+
+uint8_t model_Register(uint8_t reg)
+{
+    model_CatchUp();
+    return modelRegs[reg];
+}
+
+bool I2C1_Write(uint16_t address, uint8_t *data, size_t dataLength)
+{
+    uint8_t reg = data[0];
+    size_t index;
+
+    (void)address;
+    model_CatchUp();
+    for (index = 1; index < dataLength; index++)
+    {
+        model_Store(reg++, data[index]);
+    }
+    return true;
+}
+
+bool I2C1_WriteRead(uint16_t address, uint8_t *writeData, size_t writeLength, uint8_t *readData, size_t readLength)
+{
+    uint8_t reg = writeData[0];
+
+    (void)address;
+    (void)writeLength;
+    model_CatchUp();
+    while (readLength--)
+    {
+        *readData++ = (reg < MODEL_REGS) ? modelRegs[reg] : 0;
+        reg++;
+    }
+    return true;
+}
+
+i2c_host_error_t I2C1_ErrorGet(void)
+{
+    return I2C_ERROR_NONE;
+}
+
+bool I2C1_IsBusy(void)
+{
+    return false;
+}
+
+void I2C1_Tasks(void)
+{
+}
+
+void I2C1_Initialize(void)
+{
+}
+
+void I2C1_Deinitialize(void)
+{
+}
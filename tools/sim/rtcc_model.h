@@ -0,0 +1,19 @@
+/*
+ * File:   rtcc_model.h
+ *
+ * Register model of the MCP79410 behind the I2C1 driver, see rtcc_model.c
+ */
+#ifndef RTCC_MODEL_H
+#define RTCC_MODEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#define MODEL_OSC_START_MS          (400UL)                                   //  Crystal start up after the first ST write
+
+void model_PowerUp(void);                                                    // Registers cleared, oscillator stopped
+time_t model_Time(void);                                                     // UTC held in Seconds..Year, -1 if not a calendar time
+uint8_t model_Register(uint8_t reg);
+
+#endif
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""Checks footprint.py against fixtures/xc8_sample.map.
+
+The fixture follows the layout of an XC8 2.x map file: the per-object
+psect list, the TOTAL section by class, the symbol table and the module
+and function listing. The expected figures below are worked out by hand
+from it.
+
+    python3 tools/test_footprint.py
+"""
+
+import json
+import os
+import subprocess
+import sys
+import tempfile
+import unittest
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+MAP = os.path.join(HERE, "fixtures", "xc8_sample.map")
+TOOL = os.path.join(HERE, "footprint.py")
+LIBRARY = r"C:\Program Files\Microchip\xc8\v2.45\pic\sources\c99\common\lldiv.c"
+
+sys.path.insert(0, HERE)
+import footprint  # noqa: E402
+
+
+def run(budget, *extra):
+    """Runs the tool on the fixture with the given budget and returns its exit status."""
+    with tempfile.TemporaryDirectory() as folder:
+        path = os.path.join(folder, "budget.json")
+        if budget is not None:
+            with open(path, "w") as handle:
+                json.dump(budget, handle)
+        status = subprocess.run([sys.executable, TOOL, MAP, "--budget", path] + list(extra),
+                                stdout=subprocess.DEVNULL).returncode
+        written = None
+        if os.path.exists(path):
+            with open(path) as handle:
+                written = json.load(handle)
+        return status, written
+
+
+class ParseTest(unittest.TestCase):
+    def setUp(self):
+        with open(MAP, encoding="latin-1") as handle:
+            self.functions, self.modules, self.psects, self.symbols = footprint.parse(handle)
+
+    def test_modules_use_estimated_size_or_function_sum(self):
+        self.assertEqual(self.modules, {
+            "application.c": 416,
+            "main.c": 64,
+            "mcc_generated_files/system/src/interrupt.c": 200,
+            LIBRARY: 36,                                    # No estimated size line, summed from its functions
+        })
+
+    def test_functions_keep_their_module(self):
+        self.assertEqual(self.functions["_rtc6_ServiceAlarms"], ("application.c", 250))
+        self.assertEqual(self.functions["___lldiv"], (LIBRARY, 36))
+
+    def test_psects_come_from_the_total_section_only(self):
+        self.assertEqual(self.psects["text1"], ("CODE", 0x100, 0x1A0, 0))
+        self.assertEqual(self.psects["dataBANK1"], ("BANK1", 0xA0, 0x8, 1))
+        self.assertEqual(len(self.psects), 13)
+
+    def test_ram_symbols_sized_by_gap(self):
+        sizes = footprint.ram_symbols(self.psects, self.symbols)
+        self.assertEqual(sizes, {"_rtcHealth": 1, "_alarmArmed": 1, "_snapshots": 16, "_tsPeriod": 2, "_tsSeconds": 6})
+
+    def test_module_names_match_by_path_suffix(self):
+        self.assertEqual(footprint.module_words(self.modules, "interrupt.c"), 200)
+        self.assertEqual(footprint.module_words(self.modules, "src/interrupt.c"), 200)
+        self.assertEqual(footprint.module_words(self.modules, "lldiv.c"), 36)
+        self.assertIsNone(footprint.module_words(self.modules, "rupt.c"))
+
+
+class BudgetTest(unittest.TestCase):
+    def test_totals_leave_out_sfr_abs_and_config(self):
+        self.assertEqual(run({"flash_words": 735, "ram_bytes": 82})[0], 0)
+        self.assertEqual(run({"flash_words": 734})[0], 1)
+        self.assertEqual(run({"ram_bytes": 81})[0], 1)
+
+    def test_slack_is_a_percentage(self):
+        self.assertEqual(run({"flash_words": 721, "slack_percent": 2})[0], 0)
+        self.assertEqual(run({"flash_words": 720, "slack_percent": 2})[0], 1)
+
+    def test_module_over_budget_fails(self):
+        self.assertEqual(run({"modules": {"application.c": 416}})[0], 0)
+        self.assertEqual(run({"modules": {"application.c": 415}})[0], 1)
+
+    def test_module_missing_from_the_map(self):
+        self.assertEqual(run({"modules": {"application.c": 416, "trace.c": 10}})[0], 0)
+        self.assertEqual(run({"modules": {"trace.c": 10}})[0], 1)
+
+    def test_update_records_a_budget_the_same_map_meets(self):
+        status, written = run(None, "--update")
+        self.assertEqual(status, 0)
+        self.assertEqual(written["flash_words"], 735)
+        self.assertEqual(written["ram_bytes"], 82)
+        self.assertEqual(written["modules"]["main.c"], 64)
+        self.assertEqual(written["slack_percent"], 2)
+        self.assertEqual(run(written)[0], 0)
+
+
+if __name__ == "__main__":
+    unittest.main()
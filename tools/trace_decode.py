@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""Decode trace dumps printed by option T of the RTCC example.
+
+Reads a serial log, finds every "TRACE n" ... "END" block and prints a
+timeline in milliseconds with a summary of the I2C transactions and UART
+traffic. With --replay, the bytes the firmware read from the UART are
+written to a file that can be sent back to the board to repeat the session.
+"""
+
+import argparse
+import re
+import sys
+
+TIMER1_HZ = 31000                       # TMR1_NOMINAL_FREQUENCY, LFINTOSC
+
+EVENTS = {
+    0x01: "I2C start",
+    0x02: "I2C state",
+    0x03: "I2C error",
+    0x04: "UART rx",
+    0x05: "UART tx",
+    0x06: "UART tx block",
+}
+I2C_START, I2C_STATE, I2C_ERROR, UART_RX, UART_TX, UART_TX_BLOCK = range(1, 7)
+
+I2C_STATES = ["IDLE", "SEND_RD_ADDR", "SEND_WR_ADDR", "TX", "RX", "NACK", "ERROR", "STOP", "RESET"]
+I2C_ERRORS = ["NONE", "ADDR_NACK", "DATA_NACK", "BUS_COLLISION"]
+
+
+def parse(lines):
+    """Yields (event, data, timer1) tuples from every dump in the log."""
+    inside = False
+    for line in lines:
+        line = line.strip()
+        if re.match(r"^TRACE \d+$", line):
+            inside = True
+        elif line == "END":
+            inside = False
+        elif inside and re.match(r"^[0-9A-F]{8}$", line):
+            value = int(line, 16)
+            yield value >> 24, (value >> 16) & 0xFF, value & 0xFFFF
+
+
+def unwrap(records):
+    """Timer1 wraps every 2.1 s; records closer than that give a monotonic time."""
+    last = None
+    offset = 0
+    for event, data, timer in records:
+        if last is not None and timer < last:
+            offset += 0x10000
+        last = timer
+        yield event, data, (timer + offset) * 1000.0 / TIMER1_HZ
+
+
+def describe(event, data):
+    if event == I2C_START:
+        return "I2C start 0x%02X" % data
+    if event == I2C_STATE:
+        return "I2C -> %s" % (I2C_STATES[data] if data < len(I2C_STATES) else data)
+    if event == I2C_ERROR:
+        return "I2C error %s" % (I2C_ERRORS[data] if data < len(I2C_ERRORS) else data)
+    if event in (UART_RX, UART_TX):
+        text = chr(data) if 0x20 <= data < 0x7F else "\\x%02X" % data
+        return "%s %r" % (EVENTS[event], text)
+    return "%s %d" % (EVENTS.get(event, "event 0x%02X" % event), data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", nargs="?", type=argparse.FileType("r"), default=sys.stdin)
+    parser.add_argument("--replay", type=argparse.FileType("wb"), help="write the received UART bytes here")
+    args = parser.parse_args()
+
+    records = list(unwrap(parse(args.log)))
+    if not records:
+        sys.exit("no trace records found")
+
+    start = records[0][2]
+    transactions = []
+    opened = None
+    rx = bytearray()
+    tx = 0
+    for event, data, ms in records:
+        print("%10.3f  %s" % (ms - start, describe(event, data)))
+        if event == I2C_START:
+            opened = ms
+        elif event == I2C_STATE and data == 0 and opened is not None:
+            transactions.append(ms - opened)
+            opened = None
+        elif event == UART_RX:
+            rx.append(data)
+        elif event == UART_TX:
+            tx += 1
+        elif event == UART_TX_BLOCK:
+            tx += data
+
+    print()
+    print("records      %d over %.1f ms" % (len(records), records[-1][2] - start))
+    if transactions:
+        print("i2c          %d transactions, min %.2f avg %.2f max %.2f ms" % (
+            len(transactions), min(transactions), sum(transactions) / len(transactions), max(transactions)))
+    print("uart         %d bytes received, %d bytes queued" % (len(rx), tx))
+    if args.replay:
+        args.replay.write(bytes(rx))
+
+
+if __name__ == "__main__":
+    main()